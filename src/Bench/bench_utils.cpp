@@ -0,0 +1,161 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Bench include.
+#include "bench_utils.hpp"
+
+// Qt include.
+#include <QFile>
+#include <QTextStream>
+
+#if defined( Q_OS_WIN )
+	#include <windows.h>
+	#include <psapi.h>
+#elif !defined( Q_OS_LINUX )
+	#include <sys/resource.h>
+#endif
+
+
+namespace Globe {
+
+//
+// peakMemory
+//
+
+qint64 peakMemory()
+{
+#if defined( Q_OS_WIN )
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if( GetProcessMemoryInfo( GetCurrentProcess(), &counters,
+		sizeof( counters ) ) )
+			return static_cast< qint64 > ( counters.PeakWorkingSetSize );
+
+	return 0;
+#elif defined( Q_OS_LINUX )
+	QFile status( QStringLiteral( "/proc/self/status" ) );
+
+	if( status.open( QIODevice::ReadOnly ) )
+	{
+		QTextStream stream( &status );
+
+		QString line;
+
+		while( stream.readLineInto( &line ) )
+		{
+			if( line.startsWith( QLatin1String( "VmHWM:" ) ) )
+				return line.mid( 6 ).remove( QLatin1String( "kB" ) )
+					.trimmed().toLongLong() * 1024;
+		}
+	}
+
+	return 0;
+#else
+	struct rusage usage;
+
+	if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+	#ifdef Q_OS_MACOS
+		return static_cast< qint64 > ( usage.ru_maxrss );
+	#else
+		return static_cast< qint64 > ( usage.ru_maxrss ) * 1024;
+	#endif
+
+	return 0;
+#endif
+}
+
+
+//
+// LatencyHistogram
+//
+
+LatencyHistogram::LatencyHistogram( int maxValue )
+	:	m_buckets( maxValue + 1, 0 )
+	,	m_count( 0 )
+	,	m_sum( 0 )
+	,	m_max( 0 )
+{
+}
+
+void
+LatencyHistogram::add( qint64 value )
+{
+	value = qBound( Q_INT64_C( 0 ), value,
+		static_cast< qint64 > ( m_buckets.size() - 1 ) );
+
+	++m_buckets[ static_cast< int > ( value ) ];
+	++m_count;
+	m_sum += value;
+
+	m_max = qMax( m_max, value );
+}
+
+void
+LatencyHistogram::clear()
+{
+	m_buckets.fill( 0 );
+	m_count = 0;
+	m_sum = 0;
+	m_max = 0;
+}
+
+qint64
+LatencyHistogram::count() const
+{
+	return m_count;
+}
+
+qint64
+LatencyHistogram::percentile( double p ) const
+{
+	if( m_count == 0 )
+		return 0;
+
+	const qint64 rank = qMax( Q_INT64_C( 1 ),
+		static_cast< qint64 > ( m_count * p / 100.0 + 0.5 ) );
+
+	qint64 sum = 0;
+
+	for( int i = 0; i < m_buckets.size(); ++i )
+	{
+		sum += m_buckets.at( i );
+
+		if( sum >= rank )
+			return i;
+	}
+
+	return m_buckets.size() - 1;
+}
+
+double
+LatencyHistogram::average() const
+{
+	return ( m_count > 0 ? static_cast< double > ( m_sum ) / m_count : 0.0 );
+}
+
+qint64
+LatencyHistogram::max() const
+{
+	return m_max;
+}
+
+} /* namespace Globe */
@@ -0,0 +1,87 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__BENCH__BENCH_UTILS_HPP__INCLUDED
+#define GLOBE__BENCH__BENCH_UTILS_HPP__INCLUDED
+
+// Qt include.
+#include <QVector>
+
+
+namespace Globe {
+
+//! Max latency tracked by the histogram by default, in ms.
+static const int c_maxLatency = 10000;
+
+
+//
+// peakMemory
+//
+
+//! \return Peak resident memory of the process in bytes, 0 if unknown.
+qint64 peakMemory();
+
+
+//
+// LatencyHistogram
+//
+
+/*!
+	Histogram of the latencies with buckets of one unit (ms, us...),
+	memory doesn't grow with load.
+*/
+class LatencyHistogram {
+public:
+	explicit LatencyHistogram( int maxValue = c_maxLatency );
+
+	//! Add latency.
+	void add( qint64 value );
+
+	//! Clear.
+	void clear();
+
+	//! \return Count of the latencies.
+	qint64 count() const;
+
+	//! \return Percentile \a p (0..100).
+	qint64 percentile( double p ) const;
+
+	//! \return Average latency.
+	double average() const;
+
+	//! \return Max latency.
+	qint64 max() const;
+
+private:
+	//! Buckets.
+	QVector< qint64 > m_buckets;
+	//! Count of the latencies.
+	qint64 m_count;
+	//! Sum of the latencies.
+	qint64 m_sum;
+	//! Max latency.
+	qint64 m_max;
+}; // class LatencyHistogram
+
+} /* namespace Globe */
+
+#endif // GLOBE__BENCH__BENCH_UTILS_HPP__INCLUDED
@@ -0,0 +1,702 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Qt include.
+#include <QApplication>
+#include <QTextStream>
+#include <QString>
+#include <QTimer>
+#include <QThread>
+#include <QVector>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QAtomicInt>
+#include <QDebug>
+
+// Globe include.
+#include <Core/channels.hpp>
+#include <Core/sources.hpp>
+#include <Core/properties_manager.hpp>
+#include <Core/channel_view_window_model.hpp>
+#include <Core/log.hpp>
+#include <Scheme/scene.hpp>
+
+// Bench include.
+#include "bench_utils.hpp"
+
+// Como include.
+#include <Como/Source>
+#include <Como/ServerSocket>
+
+// Args include.
+#include <args-parser/all.hpp>
+
+
+//! Name of the benchmark's channel.
+static const QString c_loopbackChannelName =
+	QStringLiteral( "Globe.Bench.Loopback" );
+
+//! Period of the publisher's ticks in ms.
+static const int c_publishPeriod = 5;
+
+//! Period of the event loop's probe in ms.
+static const int c_probePeriod = 10;
+
+//! Max time of handling of one batch in the GUI tracked, in us.
+static const int c_maxGuiTime = 100000;
+
+
+//
+// LoopbackPublisher
+//
+
+/*!
+	Publishes sources with the Como server in it's own thread.
+	Each update has current date and time, so end-to-end latency
+	is measured on the receiving side.
+*/
+class LoopbackPublisher
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	LoopbackPublisher( int sourcesCount, quint16 port )
+		:	m_sourcesCount( sourcesCount )
+		,	m_port( port )
+		,	m_server( 0 )
+		,	m_timer( 0 )
+		,	m_next( 0 )
+		,	m_budget( 0.0 )
+		,	m_lastTick( 0 )
+		,	m_rate( 0 )
+		,	m_published( 0 )
+		,	m_publishNSecs( 0 )
+	{
+	}
+
+	//! Set count of the updates per second. Thread-safe.
+	void setRate( int rate )
+	{
+		m_rate.storeRelaxed( rate );
+	}
+
+	//! \return Count of the published updates since last call. Thread-safe.
+	qint64 takePublished()
+	{
+		return m_published.fetchAndStoreRelaxed( 0 );
+	}
+
+	//! \return Time of publishing in ns since last call. Thread-safe.
+	qint64 takePublishNSecs()
+	{
+		return m_publishNSecs.fetchAndStoreRelaxed( 0 );
+	}
+
+public slots:
+	//! Start server and publishing.
+	void start()
+	{
+		m_server = new Como::ServerSocket( QHostAddress::LocalHost, m_port,
+			this );
+
+		m_sources.reserve( m_sourcesCount );
+
+		for( int i = 0; i < m_sourcesCount; ++i )
+			m_sources.append( Como::Source( Como::Source::Int,
+				QStringLiteral( "loopback.%1" ).arg( i ),
+				QStringLiteral( "int" ), QVariant( 0 ), QString() ) );
+
+		m_timer = new QTimer( this );
+		m_timer->setTimerType( Qt::PreciseTimer );
+
+		connect( m_timer, &QTimer::timeout,
+			this, &LoopbackPublisher::tick );
+
+		m_lastTick = steadyNSecs();
+
+		m_timer->start( c_publishPeriod );
+	}
+
+	//! Stop publishing and server.
+	void stop()
+	{
+		delete m_timer;
+		m_timer = 0;
+
+		delete m_server;
+		m_server = 0;
+	}
+
+private slots:
+	//! Publish updates for the elapsed time.
+	void tick()
+	{
+		const qint64 now = steadyNSecs();
+
+		m_budget += m_rate.loadRelaxed() * ( now - m_lastTick ) / 1.0e9;
+		m_lastTick = now;
+
+		const int count = static_cast< int > ( m_budget );
+
+		if( count == 0 )
+			return;
+
+		m_budget -= count;
+
+		const QDateTime dt = QDateTime::currentDateTime();
+
+		QElapsedTimer timer;
+		timer.start();
+
+		for( int i = 0; i < count; ++i )
+		{
+			Como::Source & source = m_sources[ m_next ];
+
+			source.setValue( source.value().toInt() + 1 );
+			source.setDateTime( dt );
+
+			m_server->updateSource( source );
+
+			m_next = ( m_next + 1 ) % m_sources.size();
+		}
+
+		m_publishNSecs.fetchAndAddRelaxed( timer.nsecsElapsed() );
+		m_published.fetchAndAddRelaxed( count );
+	}
+
+private:
+	//! \return Monotonic time in ns.
+	static qint64 steadyNSecs()
+	{
+		static QElapsedTimer clock = [] () {
+			QElapsedTimer t; t.start(); return t; } ();
+
+		return clock.nsecsElapsed();
+	}
+
+private:
+	//! Count of the sources.
+	int m_sourcesCount;
+	//! Port of the server.
+	quint16 m_port;
+	//! Server.
+	Como::ServerSocket * m_server;
+	//! Timer.
+	QTimer * m_timer;
+	//! Sources.
+	QVector< Como::Source > m_sources;
+	//! Index of the next source to update.
+	int m_next;
+	//! Count of the updates to publish.
+	double m_budget;
+	//! Time of the last tick in ns.
+	qint64 m_lastTick;
+	//! Count of the updates per second.
+	QAtomicInt m_rate;
+	//! Count of the published updates.
+	QAtomicInteger< qint64 > m_published;
+	//! Time of publishing in ns.
+	QAtomicInteger< qint64 > m_publishNSecs;
+}; // class LoopbackPublisher
+
+
+//
+// StepResults
+//
+
+//! Results of one step of the measurement.
+struct StepResults {
+	StepResults()
+		:	m_published( 0 )
+		,	m_publishNSecs( 0 )
+		,	m_received( 0 )
+		,	m_delivered( 0 )
+		,	m_batches( 0 )
+		,	m_hopP50( 0 )
+		,	m_hopP99( 0 )
+		,	m_seconds( 0 )
+		,	m_gui( c_maxGuiTime )
+	{
+	}
+
+	//! Updates published by the server.
+	qint64 m_published;
+	//! Time of publishing in ns.
+	qint64 m_publishNSecs;
+	//! Updates received by the channel.
+	qint64 m_received;
+	//! Updates delivered to the views.
+	qint64 m_delivered;
+	//! Batches delivered to the views.
+	qint64 m_batches;
+	//! Sum of the per second medians of the thread hop in ms.
+	qint64 m_hopP50;
+	//! Max of the per second 99th percentiles of the thread hop in ms.
+	qint64 m_hopP99;
+	//! Count of the seconds with statistics.
+	int m_seconds;
+	//! End-to-end latencies in ms.
+	Globe::LatencyHistogram m_endToEnd;
+	//! Handling of the batches by the views in us.
+	Globe::LatencyHistogram m_gui;
+	//! Delays of the event loop in ms.
+	Globe::LatencyHistogram m_lag;
+}; // struct StepResults
+
+
+//
+// LoopbackBench
+//
+
+/*!
+	Drives steps of the rate through the real Como channel and
+	the views. Step passes while the GUI keeps up: 99th percentile
+	of the end-to-end latency is within the limit and channel
+	receives almost everything that was published.
+*/
+class LoopbackBench
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	LoopbackBench( LoopbackPublisher * publisher, Globe::Channel * channel,
+		QTextStream & out )
+		:	m_publisher( publisher )
+		,	m_channel( channel )
+		,	m_out( out )
+		,	m_rate( 0 )
+		,	m_maxRate( 0 )
+		,	m_factor( 1.5 )
+		,	m_step( 5 )
+		,	m_maxLatency( 200 )
+		,	m_isMeasuring( false )
+		,	m_isInBatch( false )
+		,	m_batchStart( 0 )
+		,	m_lastProbe( 0 )
+		,	m_sustainable( 0 )
+		,	m_probe( new QTimer( this ) )
+		,	m_results( new StepResults )
+	{
+		m_clock.start();
+
+		m_probe->setTimerType( Qt::PreciseTimer );
+
+		connect( m_probe, &QTimer::timeout,
+			this, &LoopbackBench::probe );
+
+		// Stamps beginning of the handling of the batch in the GUI
+		// thread, per source signals are emitted before the batch.
+		connect( m_channel, &Globe::Channel::sourceUpdated,
+			this, &LoopbackBench::batchStarted );
+
+		// Connected after the views, so the batch is already handled.
+		connect( m_channel, &Globe::Channel::sourcesUpdated,
+			this, &LoopbackBench::batchHandled );
+
+		connect( m_channel, &Globe::Channel::statisticsUpdated,
+			this, &LoopbackBench::statistics );
+	}
+
+	//! Set steps of the rate.
+	void setSteps( int startRate, int maxRate, double factor,
+		int stepSeconds, int maxLatency )
+	{
+		m_rate = startRate;
+		m_maxRate = maxRate;
+		m_factor = factor;
+		m_step = stepSeconds;
+		m_maxLatency = maxLatency;
+	}
+
+public slots:
+	//! Start steps.
+	void start()
+	{
+		m_out << "rate,published/s,received/s,delivered/s,publish us,"
+			"hop p50 ms,hop p99 ms,gui p50 us,gui p99 us,"
+			"e2e p50 ms,e2e p90 ms,e2e p99 ms,e2e max ms,lag p99 ms,passed"
+			<< Qt::endl;
+
+		m_probe->start( c_probePeriod );
+
+		startStep();
+	}
+
+private slots:
+	//! Start step with the current rate.
+	void startStep()
+	{
+		m_isMeasuring = false;
+
+		m_publisher->setRate( m_rate );
+
+		// Warm-up of the step.
+		QTimer::singleShot( 1000, this, &LoopbackBench::startMeasuring );
+	}
+
+	//! Start measuring of the step.
+	void startMeasuring()
+	{
+		m_publisher->takePublished();
+		m_publisher->takePublishNSecs();
+
+		m_results.reset( new StepResults );
+
+		m_isMeasuring = true;
+
+		m_stepTimer.start();
+
+		QTimer::singleShot( m_step * 1000, this, &LoopbackBench::finishStep );
+	}
+
+	//! Finish step and start the next one or finish.
+	void finishStep()
+	{
+		m_isMeasuring = false;
+
+		StepResults & r = *m_results;
+
+		r.m_published = m_publisher->takePublished();
+		r.m_publishNSecs = m_publisher->takePublishNSecs();
+
+		const double secs = m_stepTimer.elapsed() / 1000.0;
+
+		const bool passed = r.m_received >= r.m_published * 0.95 &&
+			r.m_endToEnd.percentile( 99 ) <= m_maxLatency;
+
+		m_out << m_rate << ','
+			<< qRound64( r.m_published / secs ) << ','
+			<< qRound64( r.m_received / secs ) << ','
+			<< qRound64( r.m_delivered / secs ) << ','
+			<< ( r.m_published > 0 ?
+				r.m_publishNSecs / 1000.0 / r.m_published : 0.0 ) << ','
+			<< ( r.m_seconds > 0 ? r.m_hopP50 / r.m_seconds : 0 ) << ','
+			<< r.m_hopP99 << ','
+			<< r.m_gui.percentile( 50 ) << ','
+			<< r.m_gui.percentile( 99 ) << ','
+			<< r.m_endToEnd.percentile( 50 ) << ','
+			<< r.m_endToEnd.percentile( 90 ) << ','
+			<< r.m_endToEnd.percentile( 99 ) << ','
+			<< r.m_endToEnd.max() << ','
+			<< r.m_lag.percentile( 99 ) << ','
+			<< ( passed ? "yes" : "no" ) << Qt::endl;
+
+		if( passed )
+			m_sustainable = m_rate;
+
+		const int next = static_cast< int > ( m_rate * m_factor );
+
+		if( passed && next > m_rate && next <= m_maxRate )
+		{
+			m_rate = next;
+
+			startStep();
+		}
+		else
+			finish();
+	}
+
+	//! Source updated, the first one stamps beginning of the batch.
+	void batchStarted()
+	{
+		if( !m_isInBatch )
+		{
+			m_isInBatch = true;
+
+			m_batchStart = m_clock.nsecsElapsed();
+		}
+	}
+
+	//! Batch has been handled by the views.
+	void batchHandled( const QVector< Como::Source > & batch )
+	{
+		m_isInBatch = false;
+
+		if( !m_isMeasuring )
+			return;
+
+		StepResults & r = *m_results;
+
+		r.m_gui.add( ( m_clock.nsecsElapsed() - m_batchStart ) / 1000 );
+
+		const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+		for( const auto & source : batch )
+			r.m_endToEnd.add( now - source.dateTime().toMSecsSinceEpoch() );
+
+		r.m_delivered += batch.size();
+		++r.m_batches;
+	}
+
+	//! Statistics of the channel.
+	void statistics( const Globe::ChannelStatistics & stat )
+	{
+		if( !m_isMeasuring )
+			return;
+
+		StepResults & r = *m_results;
+
+		r.m_received += stat.messagesRate();
+		r.m_hopP50 += stat.latencyP50();
+		r.m_hopP99 = qMax( r.m_hopP99, static_cast< qint64 > (
+			stat.latencyP99() ) );
+		++r.m_seconds;
+	}
+
+	//! Measure delay of the event loop.
+	void probe()
+	{
+		const qint64 now = m_clock.elapsed();
+
+		if( m_isMeasuring && m_lastProbe > 0 )
+			m_results->m_lag.add( now - m_lastProbe - c_probePeriod );
+
+		m_lastProbe = now;
+	}
+
+private:
+	//! Print results and quit.
+	void finish()
+	{
+		m_probe->stop();
+
+		m_out << "max sustainable rate: " << m_sustainable << " updates/s"
+			<< Qt::endl
+			<< "peak memory: " << Globe::peakMemory() / 1024 << " KiB"
+			<< Qt::endl;
+
+		qApp->quit();
+	}
+
+private:
+	//! Publisher.
+	LoopbackPublisher * m_publisher;
+	//! Channel.
+	Globe::Channel * m_channel;
+	//! Output.
+	QTextStream & m_out;
+	//! Current rate.
+	int m_rate;
+	//! Max rate.
+	int m_maxRate;
+	//! Factor of the rate between steps.
+	double m_factor;
+	//! Duration of the step in seconds.
+	int m_step;
+	//! Limit of the 99th percentile of the end-to-end latency in ms.
+	int m_maxLatency;
+	//! Is step measuring?
+	bool m_isMeasuring;
+	//! Is batch being handled?
+	bool m_isInBatch;
+	//! Beginning of the batch in ns.
+	qint64 m_batchStart;
+	//! Time of the last probe in ms.
+	qint64 m_lastProbe;
+	//! Max rate that passed.
+	int m_sustainable;
+	//! Monotonic clock.
+	QElapsedTimer m_clock;
+	//! Duration of the step.
+	QElapsedTimer m_stepTimer;
+	//! Probe of the event loop.
+	QTimer * m_probe;
+	//! Results of the current step.
+	QScopedPointer< StepResults > m_results;
+}; // class LoopbackBench
+
+
+int main( int argc, char ** argv )
+{
+	qRegisterMetaType< Como::Source > ( "Como::Source" );
+
+	int sources = 10000;
+	int startRate = 1000;
+	int maxRate = 1000000;
+	double factor = 1.5;
+	int step = 5;
+	int maxLatency = 200;
+	int timeout = 0;
+	int sceneItems = 100;
+	quint16 port = 4747;
+
+	try{
+		Args::CmdLine cmd;
+
+		cmd.addArgWithFlagAndName( QChar( 's' ), QLatin1String( "sources" ),
+				true, false, QLatin1String( "Count of the sources (10000)." ) )
+			.addArgWithFlagAndName( QChar( 'r' ), QLatin1String( "rate" ),
+				true, false, QLatin1String( "Measure only this rate "
+					"of the updates per second." ) )
+			.addArgWithFlagAndName( QChar( 'b' ), QLatin1String( "start" ),
+				true, false, QLatin1String( "Rate of the first step (1000)." ) )
+			.addArgWithFlagAndName( QChar( 'm' ), QLatin1String( "max" ),
+				true, false, QLatin1String( "Max rate (1000000)." ) )
+			.addArgWithFlagAndName( QChar( 'f' ), QLatin1String( "factor" ),
+				true, false, QLatin1String( "Factor of the rate between "
+					"steps (1.5)." ) )
+			.addArgWithFlagAndName( QChar( 'd' ), QLatin1String( "step" ),
+				true, false, QLatin1String( "Duration of the step "
+					"in seconds (5)." ) )
+			.addArgWithFlagAndName( QChar( 'l' ), QLatin1String( "latency" ),
+				true, false, QLatin1String( "Max 99th percentile of the "
+					"end-to-end latency in ms to pass the step (200)." ) )
+			.addArgWithFlagAndName( QChar( 't' ), QLatin1String( "timeout" ),
+				true, false, QLatin1String( "Timeout of the channel in ms (0)." ) )
+			.addArgWithFlagAndName( QChar( 'i' ), QLatin1String( "items" ),
+				true, false, QLatin1String( "Count of the sources placed "
+					"on the scheme (100)." ) )
+			.addArgWithFlagAndName( QChar( 'p' ), QLatin1String( "port" ),
+				true, false, QLatin1String( "Port of the local server (4747)." ) )
+			.addHelp( true, argv[ 0 ], QLatin1String( "End-to-end benchmark "
+				"of the Globe with the local Como server over loopback" ) );
+
+		cmd.parse( argc, argv );
+
+		if( cmd.isDefined( QLatin1String( "-s" ) ) )
+			sources = qMax( 1, cmd.value( QLatin1String( "-s" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-b" ) ) )
+			startRate = qMax( 1, cmd.value( QLatin1String( "-b" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-m" ) ) )
+			maxRate = qMax( 1, cmd.value( QLatin1String( "-m" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-r" ) ) )
+		{
+			startRate = qMax( 1, cmd.value( QLatin1String( "-r" ) ).toInt() );
+			maxRate = startRate;
+		}
+
+		if( cmd.isDefined( QLatin1String( "-f" ) ) )
+			factor = qMax( 1.01, cmd.value( QLatin1String( "-f" ) ).toDouble() );
+
+		if( cmd.isDefined( QLatin1String( "-d" ) ) )
+			step = qMax( 1, cmd.value( QLatin1String( "-d" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-l" ) ) )
+			maxLatency = qMax( 1, cmd.value( QLatin1String( "-l" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-t" ) ) )
+			timeout = qMax( 0, cmd.value( QLatin1String( "-t" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-i" ) ) )
+			sceneItems = qMax( 0, cmd.value( QLatin1String( "-i" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-p" ) ) )
+			port = static_cast< quint16 > (
+				cmd.value( QLatin1String( "-p" ) ).toUInt() );
+	}
+	catch( const Args::HelpHasBeenPrintedException & )
+	{
+		return 0;
+	}
+	catch( const Args::BaseException & x )
+	{
+		qDebug() << x.desc() << "\n";
+
+		return 1;
+	}
+
+	// Views are created without windows.
+	if( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+		qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+	QApplication app( argc, argv );
+
+	QTextStream out( stdout );
+
+	Globe::Log::instance();
+	Globe::PropertiesManager::instance();
+	Globe::SourcesManager::instance();
+
+	if( !Globe::ChannelsManager::instance().supportedChannels()
+		.contains( QLatin1String( "como" ) ) )
+	{
+		qDebug() << "Como channel plugin is not found in the"
+			<< app.applicationDirPath() + QLatin1String( "/plugins" );
+
+		return 1;
+	}
+
+	QThread publisherThread;
+	LoopbackPublisher * publisher = new LoopbackPublisher( sources, port );
+	publisher->moveToThread( &publisherThread );
+	publisherThread.start();
+
+	QMetaObject::invokeMethod( publisher, &LoopbackPublisher::start,
+		Qt::BlockingQueuedConnection );
+
+	Globe::Channel * channel = Globe::ChannelsManager::instance().createChannel(
+		c_loopbackChannelName, QStringLiteral( "127.0.0.1" ), port,
+		QLatin1String( "como" ) );
+
+	if( !channel )
+	{
+		qDebug() << "Unable to create Como channel.";
+
+		return 1;
+	}
+
+	channel->updateTimeout( timeout );
+
+	Globe::ChannelViewWindowModel model;
+	model.initModel( c_loopbackChannelName );
+
+	// Sources are placed before connection of the bench,
+	// so the scene handles batches before it.
+	Globe::Scheme::Scene scene;
+
+	for( int i = 0; i < qMin( sceneItems, sources ); ++i )
+		scene.addSource( c_loopbackChannelName,
+			Como::Source( Como::Source::Int,
+				QStringLiteral( "loopback.%1" ).arg( i ),
+				QStringLiteral( "int" ), QVariant( 0 ), QString() ),
+			QPointF( ( i % 10 ) * 100.0, ( i / 10 ) * 50.0 ) );
+
+	LoopbackBench bench( publisher, channel, out );
+	bench.setSteps( startRate, maxRate, factor, step, maxLatency );
+
+	QObject::connect( channel, &Globe::Channel::connected,
+		&bench, &LoopbackBench::start, Qt::SingleShotConnection );
+
+	channel->connectToHost();
+
+	const int res = app.exec();
+
+	Globe::ChannelsManager::instance().shutdown();
+
+	QMetaObject::invokeMethod( publisher, &LoopbackPublisher::stop,
+		Qt::BlockingQueuedConnection );
+
+	publisherThread.quit();
+	publisherThread.wait();
+
+	delete publisher;
+
+	return res;
+}
+
+#include "loopback.moc"
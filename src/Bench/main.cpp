@@ -0,0 +1,315 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Qt include.
+#include <QApplication>
+#include <QTextStream>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QDebug>
+
+// Globe include.
+#include <Core/channels.hpp>
+#include <Core/sources.hpp>
+#include <Core/properties_manager.hpp>
+#include <Core/channel_view_window_model.hpp>
+#include <Core/log.hpp>
+#include <Scheme/scene.hpp>
+
+// Bench include.
+#include "bench_utils.hpp"
+
+// Como include.
+#include <Como/Source>
+
+// Args include.
+#include <args-parser/all.hpp>
+
+
+//! Name of the benchmark's channel.
+static const QString c_benchChannelName = QStringLiteral( "Globe.Bench" );
+
+
+//
+// BenchResults
+//
+
+//! Results of the measurement.
+struct BenchResults {
+	BenchResults()
+		:	m_received( 0 )
+		,	m_delivered( 0 )
+		,	m_batches( 0 )
+		,	m_coalesced( 0 )
+		,	m_sceneItems( 0 )
+	{
+	}
+
+	//! Clear.
+	void clear()
+	{
+		*this = BenchResults();
+	}
+
+	//! Updates received by the channel.
+	qint64 m_received;
+	//! Updates delivered to the views.
+	qint64 m_delivered;
+	//! Batches delivered to the views.
+	qint64 m_batches;
+	//! Updates coalesced in the channel.
+	qint64 m_coalesced;
+	//! Items on the scene.
+	int m_sceneItems;
+	//! Latencies from generation till handling by all views.
+	Globe::LatencyHistogram m_latencies;
+}; // struct BenchResults
+
+
+int main( int argc, char ** argv )
+{
+	qRegisterMetaType< Como::Source > ( "Como::Source" );
+
+	int sources = 10000;
+	int rate = 10000;
+	int duration = 10;
+	int warmup = 2;
+	int timeout = 0;
+	int sceneItems = 100;
+	QString distribution = QStringLiteral( "uniform" );
+	bool isCsv = false;
+
+	try{
+		Args::CmdLine cmd;
+
+		cmd.addArgWithFlagAndName( QChar( 's' ), QLatin1String( "sources" ),
+				true, false, QLatin1String( "Count of the sources (10000)." ) )
+			.addArgWithFlagAndName( QChar( 'r' ), QLatin1String( "rate" ),
+				true, false, QLatin1String( "Updates per second (10000)." ) )
+			.addArgWithFlagAndName( QChar( 'D' ), QLatin1String( "distribution" ),
+				true, false, QLatin1String( "Distribution of the updates: "
+					"uniform, bursty or zipf (uniform)." ) )
+			.addArgWithFlagAndName( QChar( 'd' ), QLatin1String( "duration" ),
+				true, false, QLatin1String( "Duration of the measurement "
+					"in seconds (10)." ) )
+			.addArgWithFlagAndName( QChar( 'w' ), QLatin1String( "warmup" ),
+				true, false, QLatin1String( "Warm-up before the measurement "
+					"in seconds (2)." ) )
+			.addArgWithFlagAndName( QChar( 't' ), QLatin1String( "timeout" ),
+				true, false, QLatin1String( "Timeout of the channel in ms (0)." ) )
+			.addArgWithFlagAndName( QChar( 'i' ), QLatin1String( "items" ),
+				true, false, QLatin1String( "Count of the sources placed "
+					"on the scheme (100)." ) )
+			.addArgWithFlagAndName( QChar( 'c' ), QLatin1String( "csv" ),
+				false, false, QLatin1String( "Print results as one CSV line." ) )
+			.addHelp( true, argv[ 0 ], QLatin1String( "Headless benchmark of "
+				"the Globe's pipeline from the channel to the views" ) );
+
+		cmd.parse( argc, argv );
+
+		if( cmd.isDefined( QLatin1String( "-s" ) ) )
+			sources = qMax( 1, cmd.value( QLatin1String( "-s" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-r" ) ) )
+			rate = qMax( 0, cmd.value( QLatin1String( "-r" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-D" ) ) )
+			distribution = cmd.value( QLatin1String( "-D" ) );
+
+		if( cmd.isDefined( QLatin1String( "-d" ) ) )
+			duration = qMax( 1, cmd.value( QLatin1String( "-d" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-w" ) ) )
+			warmup = qMax( 0, cmd.value( QLatin1String( "-w" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-t" ) ) )
+			timeout = qMax( 0, cmd.value( QLatin1String( "-t" ) ).toInt() );
+
+		if( cmd.isDefined( QLatin1String( "-i" ) ) )
+			sceneItems = qMax( 0, cmd.value( QLatin1String( "-i" ) ).toInt() );
+
+		isCsv = cmd.isDefined( QLatin1String( "-c" ) );
+	}
+	catch( const Args::HelpHasBeenPrintedException & )
+	{
+		return 0;
+	}
+	catch( const Args::BaseException & x )
+	{
+		qDebug() << x.desc() << "\n";
+
+		return 1;
+	}
+
+	// Views are created without windows.
+	if( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+		qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+	QApplication app( argc, argv );
+
+	QTextStream out( stdout );
+
+	Globe::Log::instance();
+	Globe::PropertiesManager::instance();
+	Globe::SourcesManager::instance();
+
+	if( !Globe::ChannelsManager::instance().supportedChannels()
+		.contains( QLatin1String( "synthetic" ) ) )
+	{
+		qDebug() << "Synthetic channel plugin is not found in the"
+			<< app.applicationDirPath() + QLatin1String( "/plugins" );
+
+		return 1;
+	}
+
+	Globe::Channel * channel = Globe::ChannelsManager::instance().createChannel(
+		c_benchChannelName,
+		QStringLiteral( "sources=%1;rate=%2;distribution=%3" )
+			.arg( QString::number( sources ), QString::number( rate ),
+				distribution ),
+		1, QLatin1String( "synthetic" ) );
+
+	if( !channel )
+	{
+		qDebug() << "Unable to create synthetic channel.";
+
+		return 1;
+	}
+
+	channel->updateTimeout( timeout );
+
+	Globe::ChannelViewWindowModel model;
+	model.initModel( c_benchChannelName );
+
+	Globe::Scheme::Scene scene;
+
+	BenchResults results;
+	bool isMeasuring = false;
+
+	QObject::connect( &Globe::SourcesManager::instance(),
+		&Globe::SourcesManager::newSource,
+		[&] ( const Como::Source & source, const QString & channelName )
+		{
+			if( channelName == c_benchChannelName &&
+				results.m_sceneItems < sceneItems )
+			{
+				const int column = results.m_sceneItems % 10;
+				const int row = results.m_sceneItems / 10;
+
+				scene.addSource( channelName, source,
+					QPointF( column * 100.0, row * 50.0 ) );
+
+				++results.m_sceneItems;
+			}
+		} );
+
+	// Queued, so batch is measured after handling by all views.
+	QObject::connect( channel, &Globe::Channel::sourcesUpdated, &app,
+		[&] ( const QVector< Como::Source > & batch )
+		{
+			if( !isMeasuring )
+				return;
+
+			const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+			for( const auto & source : batch )
+				results.m_latencies.add( now -
+					source.dateTime().toMSecsSinceEpoch() );
+
+			results.m_delivered += batch.size();
+			++results.m_batches;
+		}, Qt::QueuedConnection );
+
+	QObject::connect( channel, &Globe::Channel::statisticsUpdated,
+		[&] ( const Globe::ChannelStatistics & stat )
+		{
+			if( !isMeasuring )
+				return;
+
+			results.m_received += stat.messagesRate();
+			results.m_coalesced += stat.coalescedCount();
+		} );
+
+	QElapsedTimer elapsed;
+
+	QTimer::singleShot( warmup * 1000, [&] ()
+		{
+			const int items = results.m_sceneItems;
+
+			results.clear();
+			results.m_sceneItems = items;
+
+			isMeasuring = true;
+
+			elapsed.start();
+		} );
+
+	QTimer::singleShot( ( warmup + duration ) * 1000, [&] ()
+		{
+			isMeasuring = false;
+
+			const double secs = elapsed.elapsed() / 1000.0;
+			const qint64 memory = Globe::peakMemory();
+
+			if( isCsv )
+				out << sources << ',' << rate << ',' << distribution << ','
+					<< timeout << ',' << results.m_sceneItems << ','
+					<< qRound64( results.m_received / secs ) << ','
+					<< qRound64( results.m_delivered / secs ) << ','
+					<< results.m_latencies.percentile( 50 ) << ','
+					<< results.m_latencies.percentile( 90 ) << ','
+					<< results.m_latencies.percentile( 99 ) << ','
+					<< results.m_latencies.max() << ','
+					<< memory << Qt::endl;
+			else
+				out << "sources: " << sources << Qt::endl
+					<< "rate: " << rate << " updates/s" << Qt::endl
+					<< "distribution: " << distribution << Qt::endl
+					<< "timeout: " << timeout << " ms" << Qt::endl
+					<< "scheme items: " << results.m_sceneItems << Qt::endl
+					<< "duration: " << secs << " s" << Qt::endl
+					<< "received: " << qRound64( results.m_received / secs )
+					<< " updates/s" << Qt::endl
+					<< "delivered: " << qRound64( results.m_delivered / secs )
+					<< " updates/s in " << results.m_batches << " batches"
+					<< Qt::endl
+					<< "coalesced: " << results.m_coalesced << Qt::endl
+					<< "latency: p50 " << results.m_latencies.percentile( 50 )
+					<< " ms, p90 " << results.m_latencies.percentile( 90 )
+					<< " ms, p99 " << results.m_latencies.percentile( 99 )
+					<< " ms, max " << results.m_latencies.max() << " ms"
+					<< Qt::endl
+					<< "peak memory: " << memory / 1024 << " KiB" << Qt::endl;
+
+			Globe::ChannelsManager::instance().shutdown();
+
+			app.quit();
+		} );
+
+	QTimer::singleShot( 0, channel, &Globe::Channel::connectToHost );
+
+	return app.exec();
+}
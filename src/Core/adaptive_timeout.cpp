@@ -0,0 +1,121 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/adaptive_timeout.hpp>
+#include <Core/channel_statistics.hpp>
+
+// Qt include.
+#include <QtGlobal>
+
+
+namespace Globe {
+
+//! Rate of the messages per second considered as high load.
+static const int c_highRate = 1000;
+//! Latency in ms considered as high load.
+static const int c_highLatency = 100;
+//! First non-zero timeout in ms.
+static const int c_timeoutStep = 250;
+//! Count of the periods with low load before decreasing of the timeout.
+static const int c_quietPeriodsToShrink = 5;
+
+
+//
+// AdaptiveTimeout
+//
+
+AdaptiveTimeout::AdaptiveTimeout( int minTimeout, int maxTimeout )
+	:	m_minTimeout( 0 )
+	,	m_maxTimeout( 0 )
+	,	m_timeout( 0 )
+	,	m_quietPeriods( 0 )
+{
+	setBounds( minTimeout, maxTimeout );
+
+	reset();
+}
+
+int
+AdaptiveTimeout::minTimeout() const
+{
+	return m_minTimeout;
+}
+
+int
+AdaptiveTimeout::maxTimeout() const
+{
+	return m_maxTimeout;
+}
+
+void
+AdaptiveTimeout::setBounds( int minTimeout, int maxTimeout )
+{
+	m_minTimeout = qMax( 0, minTimeout );
+	m_maxTimeout = qMax( m_minTimeout, maxTimeout );
+
+	m_timeout = qBound( m_minTimeout, m_timeout, m_maxTimeout );
+}
+
+int
+AdaptiveTimeout::timeout() const
+{
+	return m_timeout;
+}
+
+int
+AdaptiveTimeout::adjust( const ChannelStatistics & stat )
+{
+	const int rate = stat.messagesRate() + stat.deregistrationsRate();
+	const int latency = stat.latencyP99();
+
+	if( rate > c_highRate || latency > c_highLatency )
+	{
+		m_quietPeriods = 0;
+
+		m_timeout = ( m_timeout > 0 ? m_timeout * 2 : c_timeoutStep );
+	}
+	else if( rate < c_highRate / 4 && latency < c_highLatency / 4 )
+	{
+		if( ++m_quietPeriods >= c_quietPeriodsToShrink )
+		{
+			m_quietPeriods = 0;
+
+			m_timeout = ( m_timeout > c_timeoutStep ? m_timeout / 2 : 0 );
+		}
+	}
+	else
+		m_quietPeriods = 0;
+
+	m_timeout = qBound( m_minTimeout, m_timeout, m_maxTimeout );
+
+	return m_timeout;
+}
+
+void
+AdaptiveTimeout::reset()
+{
+	m_timeout = m_minTimeout;
+	m_quietPeriods = 0;
+}
+
+} /* namespace Globe */
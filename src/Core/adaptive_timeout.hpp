@@ -0,0 +1,88 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__ADAPTIVE_TIMEOUT_HPP__INCLUDED
+#define GLOBE__ADAPTIVE_TIMEOUT_HPP__INCLUDED
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+class ChannelStatistics;
+
+//! Value of the timeout that turns on automatic timeout in the channel.
+static const int c_autoTimeout = -1;
+//! Default minimum of the automatic timeout in ms.
+static const int c_defaultMinAutoTimeout = 0;
+//! Default maximum of the automatic timeout in ms.
+static const int c_defaultMaxAutoTimeout = 5000;
+
+
+//
+// AdaptiveTimeout
+//
+
+/*!
+	Automatic timeout of the channel.
+
+	Timeout is doubled when rate of the messages or latency
+	of the delivery to the GUI thread are above thresholds,
+	and is halved when load stays low for several periods.
+	Timeout is always kept within the given bounds.
+*/
+class CORE_EXPORT AdaptiveTimeout {
+public:
+	AdaptiveTimeout( int minTimeout = c_defaultMinAutoTimeout,
+		int maxTimeout = c_defaultMaxAutoTimeout );
+
+	//! \return Minimum timeout in ms.
+	int minTimeout() const;
+	//! \return Maximum timeout in ms.
+	int maxTimeout() const;
+	//! Set bounds of the timeout in ms.
+	void setBounds( int minTimeout, int maxTimeout );
+
+	//! \return Current timeout in ms.
+	int timeout() const;
+
+	//! Adjust timeout by the statistics of the last period. \return New timeout.
+	int adjust( const ChannelStatistics & stat );
+
+	//! Reset timeout to the minimum.
+	void reset();
+
+private:
+	//! Minimum timeout.
+	int m_minTimeout;
+	//! Maximum timeout.
+	int m_maxTimeout;
+	//! Current timeout.
+	int m_timeout;
+	//! Count of the periods with low load in a row.
+	int m_quietPeriods;
+}; // class AdaptiveTimeout
+
+} /* namespace Globe */
+
+#endif // GLOBE__ADAPTIVE_TIMEOUT_HPP__INCLUDED
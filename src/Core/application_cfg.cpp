@@ -23,14 +23,25 @@
 // Globe include
 #include <Core/application_cfg.hpp>
 
+// C++ include.
+#include <limits>
+
 
 namespace Globe {
 
+//! Default interval of writing of the sources snapshot in seconds.
+static const int c_defaultSourcesSnapshotInterval = 300;
+
+
 //
 // ApplicationCfg
 //
 
 ApplicationCfg::ApplicationCfg()
+	:	m_ioThreadsCount( 0 )
+	,	m_deregisteredSourcesMaxAge( 0 )
+	,	m_deregisteredSourcesMaxCount( 0 )
+	,	m_sourcesSnapshotInterval( c_defaultSourcesSnapshotInterval )
 {
 }
 
@@ -51,6 +62,11 @@ ApplicationCfg::ApplicationCfg( const ApplicationCfg & other )
 	,	m_soundsCfgFileName( other.soundsCfgFile() )
 	,	m_disabledSoundsCfgFileName( other.disabledSoundsCfgFile() )
 	,	m_sourcesLogWindowCfgFileName( other.sourcesLogWindowCfgFile() )
+	,	m_ioThreadsCount( other.ioThreadsCount() )
+	,	m_deregisteredSourcesMaxAge( other.deregisteredSourcesMaxAge() )
+	,	m_deregisteredSourcesMaxCount( other.deregisteredSourcesMaxCount() )
+	,	m_sourcesSnapshotFileName( other.sourcesSnapshotFile() )
+	,	m_sourcesSnapshotInterval( other.sourcesSnapshotInterval() )
 {
 }
 
@@ -71,6 +87,11 @@ ApplicationCfg::operator = ( const ApplicationCfg & other )
 		m_soundsCfgFileName = other.soundsCfgFile();
 		m_disabledSoundsCfgFileName = other.disabledSoundsCfgFile();
 		m_sourcesLogWindowCfgFileName = other.sourcesLogWindowCfgFile();
+		m_ioThreadsCount = other.ioThreadsCount();
+		m_deregisteredSourcesMaxAge = other.deregisteredSourcesMaxAge();
+		m_deregisteredSourcesMaxCount = other.deregisteredSourcesMaxCount();
+		m_sourcesSnapshotFileName = other.sourcesSnapshotFile();
+		m_sourcesSnapshotInterval = other.sourcesSnapshotInterval();
 	}
 
 	return *this;
@@ -220,6 +241,66 @@ ApplicationCfg::setSourcesLogWindowCfgFile( const QString & fileName )
 	m_sourcesLogWindowCfgFileName = fileName;
 }
 
+int
+ApplicationCfg::ioThreadsCount() const
+{
+	return m_ioThreadsCount;
+}
+
+void
+ApplicationCfg::setIOThreadsCount( int count )
+{
+	m_ioThreadsCount = count;
+}
+
+int
+ApplicationCfg::deregisteredSourcesMaxAge() const
+{
+	return m_deregisteredSourcesMaxAge;
+}
+
+void
+ApplicationCfg::setDeregisteredSourcesMaxAge( int age )
+{
+	m_deregisteredSourcesMaxAge = age;
+}
+
+int
+ApplicationCfg::deregisteredSourcesMaxCount() const
+{
+	return m_deregisteredSourcesMaxCount;
+}
+
+void
+ApplicationCfg::setDeregisteredSourcesMaxCount( int count )
+{
+	m_deregisteredSourcesMaxCount = count;
+}
+
+const QString &
+ApplicationCfg::sourcesSnapshotFile() const
+{
+	return m_sourcesSnapshotFileName;
+}
+
+void
+ApplicationCfg::setSourcesSnapshotFile( const QString & fileName )
+{
+	m_sourcesSnapshotFileName = fileName;
+}
+
+int
+ApplicationCfg::sourcesSnapshotInterval() const
+{
+	return m_sourcesSnapshotInterval;
+}
+
+void
+ApplicationCfg::setSourcesSnapshotInterval( int interval )
+{
+	m_sourcesSnapshotInterval = interval;
+}
+
 
 //
 // ApplicationCfgTag
@@ -252,7 +333,25 @@ ApplicationCfgTag::ApplicationCfgTag()
 			QLatin1String( "disabledSoundsCfgFileName" ), true )
 	,	m_sourcesLogWindowCfgFileName( *this,
 			QLatin1String( "sourcesLogWindowCfgFileName" ), true )
+	,	m_ioThreadsCount( *this, QLatin1String( "ioThreadsCount" ), false )
+	,	m_ioThreadsCountConstraint( 0, 1024 )
+	,	m_deregisteredSourcesMaxAge( *this,
+			QLatin1String( "deregisteredSourcesMaxAge" ), false )
+	,	m_deregisteredSourcesMaxCount( *this,
+			QLatin1String( "deregisteredSourcesMaxCount" ), false )
+	,	m_retentionConstraint( 0, std::numeric_limits< int >::max() )
+	,	m_sourcesSnapshotFileName( *this,
+			QLatin1String( "sourcesSnapshotFileName" ), false )
+	,	m_sourcesSnapshotInterval( *this,
+			QLatin1String( "sourcesSnapshotInterval" ), false )
+	,	m_sourcesSnapshotIntervalConstraint( 0, 24 * 60 * 60 )
 {
+	m_ioThreadsCount.set_constraint( &m_ioThreadsCountConstraint );
+	m_deregisteredSourcesMaxAge.set_constraint( &m_retentionConstraint );
+	m_deregisteredSourcesMaxCount.set_constraint( &m_retentionConstraint );
+	m_sourcesSnapshotInterval.set_constraint(
+		&m_sourcesSnapshotIntervalConstraint );
+
 }
 
 ApplicationCfgTag::ApplicationCfgTag( const ApplicationCfg & cfg )
@@ -282,7 +381,25 @@ ApplicationCfgTag::ApplicationCfgTag( const ApplicationCfg & cfg )
 			QLatin1String( "disabledSoundsCfgFileName" ), true )
 	,	m_sourcesLogWindowCfgFileName( *this,
 			QLatin1String( "sourcesLogWindowCfgFileName" ), true )
+	,	m_ioThreadsCount( *this, QLatin1String( "ioThreadsCount" ), false )
+	,	m_ioThreadsCountConstraint( 0, 1024 )
+	,	m_deregisteredSourcesMaxAge( *this,
+			QLatin1String( "deregisteredSourcesMaxAge" ), false )
+	,	m_deregisteredSourcesMaxCount( *this,
+			QLatin1String( "deregisteredSourcesMaxCount" ), false )
+	,	m_retentionConstraint( 0, std::numeric_limits< int >::max() )
+	,	m_sourcesSnapshotFileName( *this,
+			QLatin1String( "sourcesSnapshotFileName" ), false )
+	,	m_sourcesSnapshotInterval( *this,
+			QLatin1String( "sourcesSnapshotInterval" ), false )
+	,	m_sourcesSnapshotIntervalConstraint( 0, 24 * 60 * 60 )
 {
+	m_ioThreadsCount.set_constraint( &m_ioThreadsCountConstraint );
+	m_deregisteredSourcesMaxAge.set_constraint( &m_retentionConstraint );
+	m_deregisteredSourcesMaxCount.set_constraint( &m_retentionConstraint );
+	m_sourcesSnapshotInterval.set_constraint(
+		&m_sourcesSnapshotIntervalConstraint );
+
 	m_mainWindowCfgFileName.set_value( cfg.mainWindowCfgFile() );
 	m_channelsCfgFileName.set_value( cfg.channelsCfgFile() );
 	m_propertiesCfgFileName.set_value( cfg.propertiesCfgFile() );
@@ -296,6 +413,22 @@ ApplicationCfgTag::ApplicationCfgTag( const ApplicationCfg & cfg )
 	m_disabledSoundsCfgFileName.set_value( cfg.disabledSoundsCfgFile() );
 	m_sourcesLogWindowCfgFileName.set_value( cfg.sourcesLogWindowCfgFile() );
 
+	if( cfg.ioThreadsCount() )
+		m_ioThreadsCount.set_value( cfg.ioThreadsCount() );
+
+	if( cfg.deregisteredSourcesMaxAge() )
+		m_deregisteredSourcesMaxAge.set_value( cfg.deregisteredSourcesMaxAge() );
+
+	if( cfg.deregisteredSourcesMaxCount() )
+		m_deregisteredSourcesMaxCount.set_value(
+			cfg.deregisteredSourcesMaxCount() );
+
+	if( !cfg.sourcesSnapshotFile().isEmpty() )
+	{
+		m_sourcesSnapshotFileName.set_value( cfg.sourcesSnapshotFile() );
+		m_sourcesSnapshotInterval.set_value( cfg.sourcesSnapshotInterval() );
+	}
+
 	set_defined();
 }
 
@@ -317,6 +450,22 @@ ApplicationCfgTag::cfg() const
 	cfg.setDisabledSoundsCfgFile( m_disabledSoundsCfgFileName.value() );
 	cfg.setSourcesLogWindowCfgFile( m_sourcesLogWindowCfgFileName.value() );
 
+	if( m_ioThreadsCount.is_defined() )
+		cfg.setIOThreadsCount( m_ioThreadsCount.value() );
+
+	if( m_deregisteredSourcesMaxAge.is_defined() )
+		cfg.setDeregisteredSourcesMaxAge( m_deregisteredSourcesMaxAge.value() );
+
+	if( m_deregisteredSourcesMaxCount.is_defined() )
+		cfg.setDeregisteredSourcesMaxCount(
+			m_deregisteredSourcesMaxCount.value() );
+
+	if( m_sourcesSnapshotFileName.is_defined() )
+		cfg.setSourcesSnapshotFile( m_sourcesSnapshotFileName.value() );
+
+	if( m_sourcesSnapshotInterval.is_defined() )
+		cfg.setSourcesSnapshotInterval( m_sourcesSnapshotInterval.value() );
+
 	return cfg;
 }
 
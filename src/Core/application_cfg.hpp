@@ -110,6 +110,31 @@ public:
 	//! Set file name of the sources log window configuration.
 	void setSourcesLogWindowCfgFile( const QString & fileName );
 
+	//! \return Count of the I/O threads for the channels.
+	int ioThreadsCount() const;
+	//! Set count of the I/O threads for the channels.
+	void setIOThreadsCount( int count );
+
+	//! \return Max age of the deregistered source in seconds, 0 - unlimited.
+	int deregisteredSourcesMaxAge() const;
+	//! Set max age of the deregistered source in seconds.
+	void setDeregisteredSourcesMaxAge( int age );
+
+	//! \return Max count of the deregistered sources per channel, 0 - unlimited.
+	int deregisteredSourcesMaxCount() const;
+	//! Set max count of the deregistered sources per channel.
+	void setDeregisteredSourcesMaxCount( int count );
+
+	//! \return File name of the sources snapshot, empty - no snapshot.
+	const QString & sourcesSnapshotFile() const;
+	//! Set file name of the sources snapshot.
+	void setSourcesSnapshotFile( const QString & fileName );
+
+	//! \return Interval of writing of the sources snapshot in seconds.
+	int sourcesSnapshotInterval() const;
+	//! Set interval of writing of the sources snapshot in seconds.
+	void setSourcesSnapshotInterval( int interval );
+
 private:
 	//! File name of the main window configuration.
 	QString m_mainWindowCfgFileName;
@@ -135,6 +160,16 @@ private:
 	QString m_disabledSoundsCfgFileName;
 	//! File name of the sources log window configuration.
 	QString m_sourcesLogWindowCfgFileName;
+	//! Count of the I/O threads for the channels.
+	int m_ioThreadsCount;
+	//! Max age of the deregistered source in seconds.
+	int m_deregisteredSourcesMaxAge;
+	//! Max count of the deregistered sources per channel.
+	int m_deregisteredSourcesMaxCount;
+	//! File name of the sources snapshot.
+	QString m_sourcesSnapshotFileName;
+	//! Interval of writing of the sources snapshot in seconds.
+	int m_sourcesSnapshotInterval;
 }; // class ApplicationCfg
 
 
@@ -179,6 +214,22 @@ private:
 	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_disabledSoundsCfgFileName;
 	//! File name of the sources log window configuration.
 	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_sourcesLogWindowCfgFileName;
+	//! Count of the I/O threads for the channels.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_ioThreadsCount;
+	//! Constraint for the count of the I/O threads.
+	cfgfile::constraint_min_max_t< int > m_ioThreadsCountConstraint;
+	//! Max age of the deregistered source in seconds.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_deregisteredSourcesMaxAge;
+	//! Max count of the deregistered sources per channel.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_deregisteredSourcesMaxCount;
+	//! Constraint for the retention of the deregistered sources.
+	cfgfile::constraint_min_max_t< int > m_retentionConstraint;
+	//! File name of the sources snapshot.
+	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_sourcesSnapshotFileName;
+	//! Interval of writing of the sources snapshot in seconds.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_sourcesSnapshotInterval;
+	//! Constraint for the interval of writing of the sources snapshot.
+	cfgfile::constraint_min_max_t< int > m_sourcesSnapshotIntervalConstraint;
 }; // class ApplicationCfgTag
 
 } /* namespace Globe */
@@ -55,6 +55,10 @@ public:
 	quint16 m_port;
 	//! Type.
 	QString m_type;
+	//! Include patterns.
+	QStringList m_include;
+	//! Exclude patterns.
+	QStringList m_exclude;
 }; // class ChannelAttributesPrivate
 
 
@@ -121,6 +125,50 @@ ChannelAttributes::setType( const QString & t )
 	d->m_type = t;
 }
 
+const QStringList &
+ChannelAttributes::include() const
+{
+	return d->m_include;
+}
+
+void
+ChannelAttributes::setInclude( const QStringList & patterns )
+{
+	d->m_include = patterns;
+}
+
+const QStringList &
+ChannelAttributes::exclude() const
+{
+	return d->m_exclude;
+}
+
+void
+ChannelAttributes::setExclude( const QStringList & patterns )
+{
+	d->m_exclude = patterns;
+}
+
+
+//! Separator of the patterns in the line edit.
+static const QChar c_patternsSeparator = QLatin1Char( ';' );
+
+//! \return Patterns from the line edit's text.
+static inline QStringList patternsFromText( const QString & text )
+{
+	QStringList patterns;
+
+	for( const QString & p : text.split( c_patternsSeparator ) )
+	{
+		const QString pattern = p.trimmed();
+
+		if( !pattern.isEmpty() )
+			patterns.append( pattern );
+	}
+
+	return patterns;
+}
+
 
 //
 // ChannelAttributesDialogPrivate
@@ -138,12 +186,16 @@ public:
 		,	m_parent( parent )
 		,	m_checkButton( 0 )
 		,	m_checkIPv4( true )
+		,	m_isEditing( false )
 	{
 	}
 
 	//! \return State of the validation of IP address and port.
 	bool checkIPAndPort()
 	{
+		if( m_isEditing )
+			return true;
+
 		return ( ChannelsManager::instance().isAddressAndPortUnique(
 			m_ui.m_ip->text(), (quint16) m_ui.m_port->value() ) );
 	}
@@ -246,6 +298,8 @@ public:
 	QPushButton * m_checkButton;
 	//! Check IPv4?
 	bool m_checkIPv4;
+	//! Are attributes of the existing channel edited?
+	bool m_isEditing;
 }; // class ChannelAttributesDialogPrivate
 
 
@@ -283,6 +337,31 @@ ChannelAttributesDialog::init( const QStringList & types )
 	if( types.size() == 1 )
 		d->m_ui.m_type->setEnabled( false );
 
+	d->m_ui.m_include->setText(
+		d->m_attributes.include().join( c_patternsSeparator ) );
+	d->m_ui.m_exclude->setText(
+		d->m_attributes.exclude().join( c_patternsSeparator ) );
+
+	if( !d->m_attributes.name().isEmpty() )
+	{
+		d->m_isEditing = true;
+		d->m_isNameSet = true;
+		d->m_isNameUnique = true;
+		d->m_isIPSet = true;
+		d->m_isPortSet = true;
+
+		d->m_ui.m_name->setText( d->m_attributes.name() );
+		d->m_ui.m_ip->setText( d->m_attributes.address() );
+		d->m_ui.m_port->setValue( d->m_attributes.port() );
+		d->m_ui.m_type->setCurrentText( d->m_attributes.type() );
+
+		d->m_ui.m_name->setEnabled( false );
+		d->m_ui.m_ip->setEnabled( false );
+		d->m_ui.m_port->setEnabled( false );
+		d->m_ui.m_type->setEnabled( false );
+		d->m_ui.m_checkIPv4->setEnabled( false );
+	}
+
 	d->stateChanged();
 
 	connect( d->m_ui.m_name, &QLineEdit::textEdited,
@@ -408,6 +487,8 @@ ChannelAttributesDialog::ok()
 	d->m_attributes.setAddress( d->m_ui.m_ip->text() );
 	d->m_attributes.setPort( (quint16) d->m_ui.m_port->value() );
 	d->m_attributes.setType( d->m_ui.m_type->currentText() );
+	d->m_attributes.setInclude( patternsFromText( d->m_ui.m_include->text() ) );
+	d->m_attributes.setExclude( patternsFromText( d->m_ui.m_exclude->text() ) );
 
 	accept();
 }
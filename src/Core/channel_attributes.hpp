@@ -26,6 +26,7 @@
 // Qt include.
 #include <QDialog>
 #include <QScopedPointer>
+#include <QStringList>
 
 
 namespace Globe {
@@ -63,6 +64,16 @@ public:
 	//! Set type of the channel.
 	void setType( const QString & t );
 
+	//! \return Include patterns of the sources.
+	const QStringList & include() const;
+	//! Set include patterns of the sources.
+	void setInclude( const QStringList & patterns );
+
+	//! \return Exclude patterns of the sources.
+	const QStringList & exclude() const;
+	//! Set exclude patterns of the sources.
+	void setExclude( const QStringList & patterns );
+
 private:
 	Q_DISABLE_COPY( ChannelAttributes )
 
@@ -77,7 +88,12 @@ class ChannelAttributesDialogPrivate;
 // ChannelAttributesDialog
 //
 
-//! Dialog with channel's attributes.
+/*!
+	Dialog with channel's attributes.
+
+	If name in the attributes is set then attributes of the existing
+	channel are edited, only filter of the sources can be changed.
+*/
 class ChannelAttributesDialog
 	:	public QDialog
 {
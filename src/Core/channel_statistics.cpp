@@ -0,0 +1,182 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/channel_statistics.hpp>
+
+// C++ include.
+#include <algorithm>
+
+
+namespace Globe {
+
+//
+// ChannelStatistics
+//
+
+ChannelStatistics::ChannelStatistics()
+	:	m_messagesRate( 0 )
+	,	m_deregistrationsRate( 0 )
+	,	m_coalescedCount( 0 )
+	,	m_droppedCount( 0 )
+	,	m_filteredCount( 0 )
+	,	m_pendingCount( 0 )
+	,	m_latencyP50( 0 )
+	,	m_latencyP99( 0 )
+	,	m_bytesRate( 0 )
+{
+}
+
+int
+ChannelStatistics::messagesRate() const
+{
+	return m_messagesRate;
+}
+
+void
+ChannelStatistics::setMessagesRate( int rate )
+{
+	m_messagesRate = rate;
+}
+
+int
+ChannelStatistics::deregistrationsRate() const
+{
+	return m_deregistrationsRate;
+}
+
+void
+ChannelStatistics::setDeregistrationsRate( int rate )
+{
+	m_deregistrationsRate = rate;
+}
+
+int
+ChannelStatistics::coalescedCount() const
+{
+	return m_coalescedCount;
+}
+
+void
+ChannelStatistics::setCoalescedCount( int count )
+{
+	m_coalescedCount = count;
+}
+
+int
+ChannelStatistics::droppedCount() const
+{
+	return m_droppedCount;
+}
+
+void
+ChannelStatistics::setDroppedCount( int count )
+{
+	m_droppedCount = count;
+}
+
+int
+ChannelStatistics::filteredCount() const
+{
+	return m_filteredCount;
+}
+
+void
+ChannelStatistics::setFilteredCount( int count )
+{
+	m_filteredCount = count;
+}
+
+int
+ChannelStatistics::pendingCount() const
+{
+	return m_pendingCount;
+}
+
+void
+ChannelStatistics::setPendingCount( int count )
+{
+	m_pendingCount = count;
+}
+
+int
+ChannelStatistics::latencyP50() const
+{
+	return m_latencyP50;
+}
+
+void
+ChannelStatistics::setLatencyP50( int msecs )
+{
+	m_latencyP50 = msecs;
+}
+
+int
+ChannelStatistics::latencyP99() const
+{
+	return m_latencyP99;
+}
+
+void
+ChannelStatistics::setLatencyP99( int msecs )
+{
+	m_latencyP99 = msecs;
+}
+
+qint64
+ChannelStatistics::bytesRate() const
+{
+	return m_bytesRate;
+}
+
+void
+ChannelStatistics::setBytesRate( qint64 rate )
+{
+	m_bytesRate = rate;
+}
+
+//! \return Percentile \a p (0-100) of the \a samples.
+static inline int percentile( QVector< int > & samples, int p )
+{
+	const int n = ( samples.size() - 1 ) * p / 100;
+
+	std::nth_element( samples.begin(), samples.begin() + n, samples.end() );
+
+	return samples.at( n );
+}
+
+void
+ChannelStatistics::setLatencies( QVector< int > & samples )
+{
+	if( samples.isEmpty() )
+	{
+		m_latencyP50 = 0;
+		m_latencyP99 = 0;
+	}
+	else
+	{
+		m_latencyP50 = percentile( samples, 50 );
+		m_latencyP99 = percentile( samples, 99 );
+	}
+}
+
+} /* namespace Globe */
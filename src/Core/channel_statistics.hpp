@@ -0,0 +1,127 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__CHANNEL_STATISTICS_HPP__INCLUDED
+#define GLOBE__CHANNEL_STATISTICS_HPP__INCLUDED
+
+// Qt include.
+#include <QVector>
+#include <QtGlobal>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//
+// ChannelStatistics
+//
+
+//! Statistics of the channel's ingest for the last period (one second).
+class CORE_EXPORT ChannelStatistics {
+public:
+	ChannelStatistics();
+
+	//! \return Count of the received updates per second.
+	int messagesRate() const;
+	//! Set count of the received updates per second.
+	void setMessagesRate( int rate );
+
+	//! \return Count of the received deregistrations per second.
+	int deregistrationsRate() const;
+	//! Set count of the received deregistrations per second.
+	void setDeregistrationsRate( int rate );
+
+	/*!
+		\return Count of the updates per second that were replaced
+		by newer values before they were sent out.
+	*/
+	int coalescedCount() const;
+	//! Set count of the coalesced updates per second.
+	void setCoalescedCount( int count );
+
+	//! \return Count of the updates per second dropped as unchanged.
+	int droppedCount() const;
+	//! Set count of the dropped updates per second.
+	void setDroppedCount( int count );
+
+	//! \return Count of the messages per second rejected by the filter.
+	int filteredCount() const;
+	//! Set count of the filtered messages per second.
+	void setFilteredCount( int count );
+
+	//! \return Count of the sources waiting for the timeout.
+	int pendingCount() const;
+	//! Set count of the sources waiting for the timeout.
+	void setPendingCount( int count );
+
+	//! \return Median latency between socket's thread and channel's one in ms.
+	int latencyP50() const;
+	//! Set median latency in ms.
+	void setLatencyP50( int msecs );
+
+	//! \return 99th percentile of the latency in ms.
+	int latencyP99() const;
+	//! Set 99th percentile of the latency in ms.
+	void setLatencyP99( int msecs );
+
+	/*!
+		\return Estimated received bytes per second.
+
+		It's approximate size of the decoded sources, not count
+		of the bytes read from the socket.
+	*/
+	qint64 bytesRate() const;
+	//! Set estimated received bytes per second.
+	void setBytesRate( qint64 rate );
+
+	/*!
+		Set latencyP50() and latencyP99() from the \a samples.
+		Order of the samples will be changed.
+	*/
+	void setLatencies( QVector< int > & samples );
+
+private:
+	//! Messages rate.
+	int m_messagesRate;
+	//! Deregistrations rate.
+	int m_deregistrationsRate;
+	//! Coalesced count.
+	int m_coalescedCount;
+	//! Dropped count.
+	int m_droppedCount;
+	//! Filtered count.
+	int m_filteredCount;
+	//! Pending count.
+	int m_pendingCount;
+	//! Median latency.
+	int m_latencyP50;
+	//! 99th percentile of latency.
+	int m_latencyP99;
+	//! Estimated bytes rate.
+	qint64 m_bytesRate;
+}; // class ChannelStatistics
+
+} /* namespace Globe */
+
+#endif // GLOBE__CHANNEL_STATISTICS_HPP__INCLUDED
@@ -27,6 +27,8 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QToolTip>
+#include <QMenu>
+#include <QContextMenuEvent>
 
 
 namespace Globe {
@@ -56,6 +58,7 @@ public:
 		:	m_timeout( timeout )
 		,	m_mousePressed( false )
 		,	m_timeoutChanged( false )
+		,	m_isAuto( false )
 	{
 	}
 
@@ -105,6 +108,8 @@ public:
 	bool m_mousePressed;
 	//! Timeout was changed.
 	bool m_timeoutChanged;
+	//! Is timeout automatic.
+	bool m_isAuto;
 }; // class ChannelTimeoutWidgetPrivate
 
 
@@ -136,6 +141,12 @@ ChannelTimeoutWidget::minimumSizeHint() const
 	return QSize( widgetWidth, widgetHeight );
 }
 
+bool
+ChannelTimeoutWidget::isAutoTimeout() const
+{
+	return d->m_isAuto;
+}
+
 void
 ChannelTimeoutWidget::setTimeout( int t )
 {
@@ -145,9 +156,10 @@ ChannelTimeoutWidget::setTimeout( int t )
 	if( t > timeout1 )
 		t = timeout1;
 
-	const auto changed = d->m_timeout != t;
+	const auto changed = d->m_timeout != t || d->m_isAuto;
 
 	d->m_timeout = t;
+	d->m_isAuto = false;
 
 	update();
 
@@ -155,6 +167,27 @@ ChannelTimeoutWidget::setTimeout( int t )
 		emit timeoutChanged( d->m_timeout );
 }
 
+void
+ChannelTimeoutWidget::setAutoTimeout( bool on )
+{
+	if( d->m_isAuto != on )
+	{
+		d->m_isAuto = on;
+
+		update();
+
+		emit autoTimeoutChanged( on );
+	}
+}
+
+void
+ChannelTimeoutWidget::showTimeout( int t )
+{
+	d->m_timeout = qBound( timeout6, t, timeout1 );
+
+	update();
+}
+
 void
 ChannelTimeoutWidget::paintEvent( QPaintEvent * event )
 {
@@ -163,7 +196,7 @@ ChannelTimeoutWidget::paintEvent( QPaintEvent * event )
 	QPainter painter( this );
 
 	painter.setPen( Qt::NoPen );
-	painter.setBrush( Qt::darkGreen );
+	painter.setBrush( d->m_isAuto ? Qt::darkBlue : Qt::darkGreen );
 
 	painter.setWindow( 0, 0, widgetWidth, widgetHeight );
 
@@ -188,6 +221,7 @@ ChannelTimeoutWidget::mouseMoveEvent( QMouseEvent * event )
 		const int timeout = d->timeoutForColumn( column );
 		if( d->m_timeout != timeout )
 		{
+			d->m_isAuto = false;
 			d->m_timeoutChanged = true;
 			d->m_timeout = timeout;
 			update();
@@ -202,12 +236,16 @@ ChannelTimeoutWidget::mouseMoveEvent( QMouseEvent * event )
 void
 ChannelTimeoutWidget::mousePressEvent( QMouseEvent * event )
 {
+	if( event->button() != Qt::LeftButton )
+		return;
+
 	d->m_mousePressed = true;
 	const int column = d->column( event->position().x() );
 	const int timeout = d->timeoutForColumn( column );
 
-	if( d->m_timeout != timeout )
+	if( d->m_timeout != timeout || d->m_isAuto )
 	{
+		d->m_isAuto = false;
 		d->m_timeout = timeout;
 		update();
 
@@ -250,10 +288,28 @@ ChannelTimeoutWidget::toolTipEvent( QEvent * event )
 	event->accept();
 }
 
+void
+ChannelTimeoutWidget::contextMenuEvent( QContextMenuEvent * event )
+{
+	QMenu menu( this );
+
+	QAction * autoAction = menu.addAction( tr( "Automatic Timeout" ) );
+	autoAction->setCheckable( true );
+	autoAction->setChecked( d->m_isAuto );
+
+	if( menu.exec( event->globalPos() ) == autoAction )
+		setAutoTimeout( autoAction->isChecked() );
+
+	event->accept();
+}
+
 QString
 ChannelTimeoutWidget::prepareToolTip() const
 {
-	if( d->m_timeout == 0 )
+	if( d->m_isAuto )
+		return tr( "Automatic timeout, currently %1 seconds." )
+			.arg( (double) d->m_timeout / 1000.0 );
+	else if( d->m_timeout == 0 )
 		return tr( "Without timeout." );
 	else
 	{
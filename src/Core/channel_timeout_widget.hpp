@@ -48,6 +48,8 @@ class ChannelTimeoutWidget
 signals:
 	//! Emits when user change timeout.
 	void timeoutChanged( int msecs );
+	//! Emits when user turns on/off automatic timeout.
+	void autoTimeoutChanged( bool on );
 
 public:
 	ChannelTimeoutWidget( int timeout = 0,
@@ -57,9 +59,16 @@ public:
 	QSize sizeHint() const;
 	QSize minimumSizeHint() const;
 
+	//! \return Is timeout automatic.
+	bool isAutoTimeout() const;
+
 public slots:
-	//! Set timeout.
+	//! Set timeout. Turns off automatic timeout.
 	void setTimeout( int t );
+	//! Turn on/off automatic timeout.
+	void setAutoTimeout( bool on );
+	//! Show current value of the automatic timeout.
+	void showTimeout( int t );
 
 protected:
 	void paintEvent( QPaintEvent * event );
@@ -68,6 +77,7 @@ protected:
 	void mouseReleaseEvent( QMouseEvent * event );
 	bool event( QEvent * event );
 	void toolTipEvent( QEvent * event );
+	void contextMenuEvent( QContextMenuEvent * event );
 
 private:
 	//! \return Tool tip for current state of the widget.
@@ -260,7 +260,10 @@ ChannelView::drawRow( QPainter * painter, const QStyleOptionViewItem & option,
 		{
 			const QModelIndex actualIndex = d->m_sortModel->mapToSource( index );
 
-			if( !d->m_model->isRegistered( actualIndex ) )
+			if( d->m_model->isStale( actualIndex ) )
+				painter->fillRect( option.rect,
+					ColorForLevel::instance().disconnectedColor() );
+			else if( !d->m_model->isRegistered( actualIndex ) )
 				painter->fillRect( option.rect,
 					ColorForLevel::instance().deregisteredColor() );
 			else
@@ -24,14 +24,19 @@
 #include <Core/channel_view_window_model.hpp>
 #include <Core/properties_manager.hpp>
 #include <Core/sources.hpp>
+#include <Core/source_id.hpp>
 #include <Core/channels.hpp>
 
 // Qt include.
 #include <QList>
+#include <QHash>
 #include <QByteArray>
 #include <QDataStream>
 #include <QMimeData>
 
+// C++ include.
+#include <algorithm>
+
 
 namespace Globe {
 
@@ -42,23 +47,24 @@ namespace Globe {
 class ChannelViewWindowModelData {
 public:
 	ChannelViewWindowModelData()
-		:	m_priority( 0 )
+		:	m_id( c_invalidSourceId )
+		,	m_priority( 0 )
 		,	m_isRegistered( false )
 		,	m_level( None )
 	{
 	}
 
-	ChannelViewWindowModelData( const Como::Source & source,
+	ChannelViewWindowModelData( SourceId id,
 		int priority, bool isRegistered, Level level )
-		:	m_source( source )
+		:	m_id( id )
 		,	m_priority( priority )
 		,	m_isRegistered( isRegistered )
 		,	m_level( level )
 	{
 	}
 
-	//! Source.
-	Como::Source m_source;
+	//! Identifier of the source, value is in the sources manager.
+	SourceId m_id;
 	//! Priority.
 	int m_priority;
 	//! Is source registered?
@@ -80,19 +86,120 @@ public:
 	}
 
 	//! \return Index of the data with the given source.
-	int findData( const Como::Source & source )
+	int findData( const Como::Source & source ) const
+	{
+		return findData( SourceIds::instance().find( m_channelName, source ) );
+	}
+
+	//! \return Index of the data with the given identifier.
+	int findData( SourceId id ) const
+	{
+		return m_index.value( id, -1 );
+	}
+
+	//! \return Source of the data.
+	const Como::Source & source( const ChannelViewWindowModelData & data ) const
+	{
+		return SourcesManager::instance().source( data.m_id );
+	}
+
+	//! Append data.
+	void appendData( SourceId id, bool isRegistered )
+	{
+		ChannelViewWindowModelData data;
+		data.m_id = id;
+		data.m_isRegistered = isRegistered;
+
+		updateLevel( data );
+
+		m_index.insert( id, m_data.size() );
+		m_data.append( data );
+	}
+
+	//! Append data.
+	void appendData( const Como::Source & source, bool isRegistered )
+	{
+		appendData( SourceIds::instance().id( m_channelName, source ),
+			isRegistered );
+	}
+
+	//! Append evaluated data.
+	void appendData( const EvaluatedSource & evaluated, bool isRegistered )
+	{
+		m_index.insert( evaluated.id(), m_data.size() );
+		m_data.append( ChannelViewWindowModelData( evaluated.id(),
+			evaluated.priority(), isRegistered, evaluated.level() ) );
+	}
+
+	//! Update priority and level of the data.
+	void updateLevel( ChannelViewWindowModelData & data ) const
+	{
+		const Como::Source & s = source( data );
+
+		const Properties * props = PropertiesManager::instance().findProperties(
+			data.m_id, s, m_channelName );
+
+		int priority = 0;
+		Level level = None;
+
+		if( props )
+		{
+			priority = props->priority();
+
+			level = props->checkConditions( s.value(), s.type() ).level();
+		}
+
+		data.m_priority = priority;
+		data.m_level = level;
+	}
+
+	//! Clear data.
+	void clearData()
 	{
-		const int size = m_data.size();
+		m_data.clear();
+		m_index.clear();
+	}
+
+	//! Fill data with the sources of the channel from the sources manager.
+	void fillData()
+	{
+		const SourcesManager & manager = SourcesManager::instance();
+
+		const int rows = manager.registeredSourcesCount( m_channelName ) +
+			manager.deregisteredSourcesCount( m_channelName );
 
-		for( int i = 0; i < size; ++i )
-			if( m_data.at( i ).m_source == source )
-				return i;
+		m_data.reserve( rows );
+		m_index.reserve( rows );
 
-		return -1;
+		manager.forEachSource( m_channelName,
+			[this] ( SourceId id, const Como::Source &, bool isRegistered )
+			{
+				if( isRegistered )
+					appendData( id, true );
+			} );
+
+		manager.forEachSource( m_channelName,
+			[this] ( SourceId id, const Como::Source &, bool isRegistered )
+			{
+				if( !isRegistered )
+					appendData( id, false );
+			} );
+	}
+
+	//! Rebuild index of the data.
+	void rebuildIndex()
+	{
+		m_index.clear();
+		m_index.reserve( m_data.size() );
+
+		for( int i = 0, last = m_data.size(); i < last; ++i )
+			m_index.insert( m_data.at( i ).m_id, i );
 	}
 
 	//! Data.
 	QList< ChannelViewWindowModelData > m_data;
+	//! Index of the data.
+	QHash< SourceId, int > m_index;
 	//! Channel name.
 	QString m_channelName;
 	//! Is channel connected?
@@ -152,67 +259,24 @@ ChannelViewWindowModel::initModel( const QString & channelName )
 				this, &ChannelViewWindowModel::disconnected );
 			connect( channel, &Channel::sourceDeregistered,
 				this, &ChannelViewWindowModel::sourceDeregistered );
-			connect( channel, &Channel::sourceUpdated,
-				this, &ChannelViewWindowModel::sourceUpdated );
 
-			const QList< Como::Source > registered = SourcesManager::instance()
-				.registeredSources( d->m_channelName );
+			connect( &SourcesManager::instance(),
+				&SourcesManager::sourcesEvaluated,
+				this, &ChannelViewWindowModel::sourcesEvaluated );
+			connect( &SourcesManager::instance(),
+				&SourcesManager::sourcesEvicted,
+				this, &ChannelViewWindowModel::sourcesEvicted );
 
-			const QList< Como::Source > deregistered = SourcesManager::instance()
-				.deregisteredSources( d->m_channelName );
+			const SourcesManager & manager = SourcesManager::instance();
 
-			const int registeredCount = registered.size();
-			const int deregisteredCount = deregistered.size();
-			const int rows = registeredCount + deregisteredCount;
+			const int rows = manager.registeredSourcesCount( d->m_channelName ) +
+				manager.deregisteredSourcesCount( d->m_channelName );
 
 			if( rows > 0 )
 			{
 				beginInsertRows( QModelIndex(), 0, rows - 1 );
 
-				for( int i = 0; i < registeredCount; ++i )
-				{
-					const Como::Source & source = registered.at( i );
-
-					const Properties * props = PropertiesManager::instance()
-						.findProperties( source, d->m_channelName, 0 );
-
-					int priority = 0;
-					Level level = None;
-
-					if( props )
-					{
-						priority = props->priority();
-
-						level = props->checkConditions( source.value(),
-							source.type() ).level();
-					}
-
-					d->m_data.insert( i, ChannelViewWindowModelData( source, priority,
-						true, level ) );
-				}
-
-				for( int i = 0; i < deregisteredCount; ++i )
-				{
-					const Como::Source & source = deregistered.at( i );
-
-					const Properties * props = PropertiesManager::instance()
-						.findProperties( source, d->m_channelName, 0 );
-
-					int priority = 0;
-					Level level = None;
-
-					if( props )
-					{
-						priority = props->priority();
-
-						level = props->checkConditions( source.value(),
-							source.type() ).level();
-					}
-
-					d->m_data.insert( registeredCount + i,
-						ChannelViewWindowModelData( source, priority,
-							false, level ) );
-				}
+				d->fillData();
 
 				endInsertRows();
 			}
@@ -225,7 +289,7 @@ ChannelViewWindowModel::clear()
 {
 	beginResetModel();
 
-	d->m_data.clear();
+	d->clearData();
 
 	d->m_isConnected = false;
 
@@ -236,6 +300,13 @@ ChannelViewWindowModel::clear()
 
 		if( oldChannel )
 			disconnect( oldChannel, 0, this, 0 );
+
+		disconnect( &SourcesManager::instance(),
+			&SourcesManager::sourcesEvaluated,
+			this, &ChannelViewWindowModel::sourcesEvaluated );
+		disconnect( &SourcesManager::instance(),
+			&SourcesManager::sourcesEvicted,
+			this, &ChannelViewWindowModel::sourcesEvicted );
 	}
 
 	endResetModel();
@@ -248,22 +319,24 @@ ChannelViewWindowModel::addItem( const Como::Source & source, bool isRegistered
 
 	beginInsertRows( QModelIndex(), size, size );
 
-	const Properties * props = PropertiesManager::instance().findProperties(
-		source, d->m_channelName, 0 );
+	d->appendData( source, isRegistered );
 
-	int priority = 0;
-	Level level = None;
+	endInsertRows();
+}
 
-	if( props )
-	{
-		priority = props->priority();
+void
+ChannelViewWindowModel::addItems( const QVector< Como::Source > & sources,
+	bool isRegistered )
+{
+	if( sources.isEmpty() )
+		return;
 
-		level = props->checkConditions( source.value(),
-			source.type() ).level();
-	}
+	const int size = d->m_data.size();
 
-	d->m_data.insert( size, ChannelViewWindowModelData( source, priority,
-		isRegistered, level ) );
+	beginInsertRows( QModelIndex(), size, size + sources.size() - 1 );
+
+	for( const auto & source : sources )
+		d->appendData( source, isRegistered );
 
 	endInsertRows();
 }
@@ -271,7 +344,7 @@ ChannelViewWindowModel::addItem( const Como::Source & source, bool isRegistered
 const Como::Source &
 ChannelViewWindowModel::source( const QModelIndex & index ) const
 {
-	return d->m_data.at( index.row() ).m_source;
+	return d->source( d->m_data.at( index.row() ) );
 }
 
 bool
@@ -286,6 +359,12 @@ ChannelViewWindowModel::level( const QModelIndex & index ) const
 	return d->m_data.at( index.row() ).m_level;
 }
 
+bool
+ChannelViewWindowModel::isStale( const QModelIndex & index ) const
+{
+	return SourcesManager::instance().isStale( d->m_data.at( index.row() ).m_id );
+}
+
 int
 ChannelViewWindowModel::priority( const QModelIndex & index ) const
 {
@@ -307,31 +386,63 @@ ChannelViewWindowModel::sourceUpdated( const Como::Source & source )
 	{
 		ChannelViewWindowModelData & data = d->m_data[ index ];
 
-		data.m_source = source;
+		data.m_isRegistered = true;
+
+		d->updateLevel( data );
 
-		const Properties * props = PropertiesManager::instance().findProperties(
-			source, d->m_channelName, 0 );
+		emit dataChanged( QAbstractTableModel::index( index, valueColumn ),
+			QAbstractTableModel::index( index, priorityColumn ) );
+	}
+	else
+		addItem( source, true );
+}
 
-		int priority = 0;
-		Level level = None;
+void
+ChannelViewWindowModel::sourcesEvaluated(
+	const QVector< EvaluatedSource > & sources, const QString & channelName )
+{
+	if( channelName != d->m_channelName )
+		return;
 
-		if( props )
+	int first = -1;
+	int last = -1;
+
+	QVector< const EvaluatedSource* > newSources;
+
+	for( const auto & evaluated : sources )
+	{
+		const int index = d->findData( evaluated.id() );
+
+		if( index != -1 )
 		{
-			priority = props->priority();
+			ChannelViewWindowModelData & data = d->m_data[ index ];
 
-			level = props->checkConditions( source.value(),
-				source.type() ).level();
+			data.m_isRegistered = true;
+			data.m_level = evaluated.level();
+			data.m_priority = evaluated.priority();
+
+			first = ( first == -1 ? index : qMin( first, index ) );
+			last = qMax( last, index );
 		}
+		else
+			newSources.append( &evaluated );
+	}
 
-		data.m_priority = priority;
-		data.m_level = level;
-		data.m_isRegistered = true;
+	if( first != -1 )
+		emit dataChanged( QAbstractTableModel::index( first, priorityColumn ),
+			QAbstractTableModel::index( last, valueColumn ) );
 
-		emit dataChanged( QAbstractTableModel::index( index, valueColumn ),
-			QAbstractTableModel::index( index, priorityColumn ) );
+	if( !newSources.isEmpty() )
+	{
+		const int size = d->m_data.size();
+
+		beginInsertRows( QModelIndex(), size, size + newSources.size() - 1 );
+
+		for( const auto * evaluated : qAsConst( newSources ) )
+			d->appendData( *evaluated, true );
+
+		endInsertRows();
 	}
-	else
-		addItem( source, true );
 }
 
 void
@@ -343,10 +454,8 @@ ChannelViewWindowModel::sourceDeregistered( const Como::Source & source )
 	{
 		ChannelViewWindowModelData & data = d->m_data[ index ];
 
-		data.m_source = source;
-
 		const Properties * props = PropertiesManager::instance().findProperties(
-			source, d->m_channelName, 0 );
+			data.m_id, source, d->m_channelName );
 
 		int priority = 0;
 
@@ -364,13 +473,66 @@ ChannelViewWindowModel::sourceDeregistered( const Como::Source & source )
 		addItem( source, false );
 }
 
+void
+ChannelViewWindowModel::sourcesEvicted( const QVector< Como::Source > & sources,
+	const QString & channelName )
+{
+	if( channelName != d->m_channelName )
+		return;
+
+	QVector< int > rows;
+	rows.reserve( sources.size() );
+
+	for( const auto & source : sources )
+	{
+		const int index = d->findData( source );
+
+		if( index != -1 )
+			rows.append( index );
+	}
+
+	if( rows.isEmpty() )
+		return;
+
+	std::sort( rows.begin(), rows.end() );
+
+	// Remove contiguous ranges of rows from the end.
+	int i = rows.size() - 1;
+
+	while( i >= 0 )
+	{
+		const int last = rows.at( i );
+		int first = last;
+
+		while( i > 0 && rows.at( i - 1 ) == first - 1 )
+		{
+			--i;
+			--first;
+		}
+
+		--i;
+
+		beginRemoveRows( QModelIndex(), first, last );
+
+		d->m_data.erase( d->m_data.begin() + first,
+			d->m_data.begin() + last + 1 );
+
+		endRemoveRows();
+	}
+
+	d->rebuildIndex();
+}
+
 void
 ChannelViewWindowModel::connected()
 {
 	d->m_isConnected = true;
 
+	// Known sources stay in the model as deregistered or stale
+	// until the channel updates them.
 	beginResetModel();
-	d->m_data.clear();
+	d->clearData();
+	d->fillData();
 	endResetModel();
 }
 
@@ -402,8 +564,10 @@ ChannelViewWindowModel::propertiesChanged()
 	{
 		ChannelViewWindowModelData & data = d->m_data[ i ];
 
+		const Como::Source & source = d->source( data );
+
 		const Properties * props = PropertiesManager::instance().findProperties(
-			data.m_source, d->m_channelName, 0 );
+			data.m_id, source, d->m_channelName );
 
 		int priority = 0;
 		Level level = None;
@@ -412,8 +576,8 @@ ChannelViewWindowModel::propertiesChanged()
 		{
 			priority = props->priority();
 
-			level = props->checkConditions( data.m_source.value(),
-				data.m_source.type() ).level();
+			level = props->checkConditions( source.value(),
+				source.type() ).level();
 		}
 
 		if( priority != data.m_priority )
@@ -464,24 +628,26 @@ ChannelViewWindowModel::data( const QModelIndex & index, int role ) const
 
 	if( role == Qt::DisplayRole )
 	{
+		const ChannelViewWindowModelData & data = d->m_data[ index.row() ];
+
 		switch( column )
 		{
 			case sourceNameColumn :
-				return ( d->m_data[ index.row() ].m_source.name() );
+				return d->source( data ).name();
 			case sourceTypeNameColumn :
-				return d->m_data[ index.row() ].m_source.typeName();
+				return d->source( data ).typeName();
 			case valueColumn :
-				return d->m_data[ index.row() ].m_source.value();
+				return d->source( data ).value();
 			case dateTimeColumn :
-				return d->m_data[ index.row() ].m_source.dateTime();
+				return d->source( data ).dateTime();
 			case priorityColumn :
-				return d->m_data[ index.row() ].m_priority;
+				return data.m_priority;
 			default :
 				return QVariant();
 		}
 	}
 	else if( role == Qt::ToolTipRole )
-		return d->m_data[ index.row() ].m_source.description();
+		return d->source( d->m_data[ index.row() ] ).description();
 	else
 		return QVariant();
 }
@@ -492,22 +658,12 @@ ChannelViewWindowModel::setData( const QModelIndex & index, const QVariant & val
 	const int column = index.column();
 	const int row = index.row();
 
-	if( role == Qt::DisplayRole )
-	{
-		switch( column )
-		{
-			case sourceNameColumn :
-				d->m_data[ row ].m_source.setName( value.toString() ); break;
-			case sourceTypeNameColumn :
-				d->m_data[ row ].m_source.setTypeName( value.toString() ); break;
-			case valueColumn :
-				d->m_data[ row ].m_source.setValue(	value ); break;
-			case dateTimeColumn :
-				d->m_data[ row ].m_source.setDateTime( value.toDateTime() ); break;
-			case priorityColumn :
-				d->m_data[ row ].m_priority = value.toInt(); break;
-		}
-	}
+	// Values of the sources are shared with other views in the
+	// sources manager, so only priority can be set here.
+	if( role != Qt::DisplayRole || column != priorityColumn )
+		return false;
+
+	d->m_data[ row ].m_priority = value.toInt();
 
 	emit dataChanged( QAbstractTableModel::index( row, column ),
 		QAbstractTableModel::index( row, column ) );
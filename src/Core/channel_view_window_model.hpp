@@ -27,11 +27,16 @@
 #include <QAbstractTableModel>
 #include <QScopedPointer>
 
+// Qt include.
+#include <QVector>
+
 // Como include.
 #include <Como/Source>
 
 // Globe include.
+#include <Core/export.hpp>
 #include <Core/condition.hpp>
+#include <Core/sources.hpp>
 
 
 namespace Globe {
@@ -53,7 +58,7 @@ class Channel;
 class ChannelViewWindowModelPrivate;
 
 //! Model with Como::Source sources.
-class ChannelViewWindowModel
+class CORE_EXPORT ChannelViewWindowModel
 	:	public QAbstractTableModel
 {
 	Q_OBJECT
@@ -76,13 +81,22 @@ public:
 	//! Clear model.
 	void clear();
 
-	//! Add new item.
+	/*!
+		Add new item.
+
+		Value of the source is read from the sources manager, so
+		source should be known to it.
+	*/
 	void addItem( const Como::Source & source, bool isRegistered );
+	//! Add new items. \sa addItem
+	void addItems( const QVector< Como::Source > & sources, bool isRegistered );
 
-	//! \return Como source for the given index.
+	//! \return Como source for the given index, shared with other views.
 	const Como::Source & source( const QModelIndex & index ) const;
 	//! \return Is source registered?
 	bool isRegistered( const QModelIndex & index ) const;
+	//! \return Is source stale, i.e. restored from the snapshot?
+	bool isStale( const QModelIndex & index ) const;
 	//! \return Level.
 	Level level( const QModelIndex & index ) const;
 	//! \return Priority.
@@ -113,8 +127,14 @@ public:
 private slots:
 	//! Source updated.
 	void sourceUpdated( const Como::Source & source );
+	//! Sources updated and evaluated.
+	void sourcesEvaluated( const QVector< Globe::EvaluatedSource > & sources,
+		const QString & channelName );
 	//! Source deregistered.
 	void sourceDeregistered( const Como::Source & source );
+	//! Deregistered sources evicted.
+	void sourcesEvicted( const QVector< Como::Source > & sources,
+		const QString & channelName );
 	//! Channel connected.
 	void connected();
 	//! Channel disconnected.
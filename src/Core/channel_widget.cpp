@@ -50,6 +50,8 @@ public:
 		,	m_timeoutWidget( 0 )
 		,	m_rateLabel( 0 )
 		,	m_rateUnits( 0 )
+		,	m_statLabel( 0 )
+		,	m_reconnectLabel( 0 )
 		,	m_connectButton( 0 )
 		,	m_disconnectButton( 0 )
 		,	m_reconnectButton( 0 )
@@ -78,6 +80,10 @@ public:
 	QLabel * m_rateLabel;
 	//! Rate units label.
 	QLabel * m_rateUnits;
+	//! Pending sources and latency label.
+	QLabel * m_statLabel;
+	//! Reconnection state label.
+	QLabel * m_reconnectLabel;
 	//! Connect button.
 	QToolButton * m_connectButton;
 	//! Disconnect button.
@@ -161,6 +167,7 @@ ChannelWidget::init()
 
 	d->m_timeoutWidget = new ChannelTimeoutWidget( d->m_channel->timeout(),
 		this );
+	d->m_timeoutWidget->setAutoTimeout( d->m_channel->isAutoTimeout() );
 	rateAndTimeoutLayout->addWidget( d->m_timeoutWidget );
 
 	d->m_rateLabel = new QLabel( this );
@@ -179,6 +186,16 @@ ChannelWidget::init()
 
 	labelsLayout->addLayout( rateAndTimeoutLayout );
 
+	d->m_statLabel = new QLabel( this );
+	d->m_statLabel->setToolTip( tr( "Count of the pending sources and "
+		"median/99th percentile of the latency." ) );
+	labelsLayout->addWidget( d->m_statLabel );
+
+	d->m_reconnectLabel = new QLabel( this );
+	d->m_reconnectLabel->setToolTip( tr( "Scheduled reconnection attempt." ) );
+	d->m_reconnectLabel->hide();
+	labelsLayout->addWidget( d->m_reconnectLabel );
+
 	QSpacerItem * vLabelsSpacer =
 		new QSpacerItem( spacerSize, spacerSize,
 			QSizePolicy::Minimum, QSizePolicy::Expanding );
@@ -227,18 +244,26 @@ ChannelWidget::init()
 
 	connect( d->m_timeoutWidget, &ChannelTimeoutWidget::timeoutChanged,
 		this, &ChannelWidget::timeoutChanged );
-	connect( d->m_channel, &Channel::messagesRate,
-		this, &ChannelWidget::messageRate );
+	connect( d->m_timeoutWidget, &ChannelTimeoutWidget::autoTimeoutChanged,
+		this, &ChannelWidget::autoTimeoutChanged );
+	connect( d->m_channel, &Channel::timeoutChanged,
+		d->m_timeoutWidget, &ChannelTimeoutWidget::showTimeout );
+	connect( d->m_channel, &Channel::statisticsUpdated,
+		this, &ChannelWidget::statisticsUpdated );
 	connect( d->m_channel, &Channel::connected,
 		this, &ChannelWidget::connected );
 	connect( d->m_channel, &Channel::disconnected,
 		this, &ChannelWidget::disconnected );
+	connect( d->m_channel, &Channel::reconnectStateChanged,
+		this, &ChannelWidget::reconnectStateChanged );
 	connect( d->m_connectButton, &QToolButton::clicked,
 		this, &ChannelWidget::connectButtonClicked );
 	connect( d->m_disconnectButton, &QToolButton::clicked,
 		this, &ChannelWidget::disconnectButtonClicked );
 	connect( d->m_reconnectButton, &QToolButton::clicked,
 		this, &ChannelWidget::reconnectButtonClicked );
+
+	statisticsUpdated( d->m_channel->statistics() );
 }
 
 QSize
@@ -259,6 +284,16 @@ ChannelWidget::minimumSizeHint() const
 		d->m_rateLabel->minimumSizeHint().width() +
 		d->m_rateUnits->minimumSizeHint().width() ) );
 
+	height += ( labelsLayoutSpacing + d->m_statLabel->minimumSizeHint().height() );
+	width = qMax( width, d->m_statLabel->minimumSizeHint().width() );
+
+	if( !d->m_reconnectLabel->isHidden() )
+	{
+		height += ( labelsLayoutSpacing +
+			d->m_reconnectLabel->minimumSizeHint().height() );
+		width = qMax( width, d->m_reconnectLabel->minimumSizeHint().width() );
+	}
+
 	width += d->m_connectButton->minimumSizeHint().width();
 	height = qMax( height, d->m_connectButton->minimumSizeHint().height() * 3 );
 
@@ -280,7 +315,10 @@ ChannelWidget::channel() const
 void
 ChannelWidget::setTimeout( int t )
 {
-	d->m_timeoutWidget->setTimeout( t );
+	if( t == c_autoTimeout )
+		d->m_timeoutWidget->setAutoTimeout( true );
+	else
+		d->m_timeoutWidget->setTimeout( t );
 }
 
 void
@@ -290,9 +328,36 @@ ChannelWidget::timeoutChanged( int msecs )
 }
 
 void
-ChannelWidget::messageRate( int msgCount )
+ChannelWidget::autoTimeoutChanged( bool on )
+{
+	if( on )
+		d->m_channel->updateTimeout( c_autoTimeout );
+	else
+		d->m_channel->updateTimeout( d->m_channel->timeout() );
+}
+
+void
+ChannelWidget::statisticsUpdated( const Globe::ChannelStatistics & stat )
 {
-	d->m_rateLabel->setText( QString::number( msgCount ) );
+	d->m_rateLabel->setText( QString::number( stat.messagesRate() ) );
+	d->m_rateLabel->setToolTip( tr( "Count of messages per second.\n"
+		"Updates: %1 msg/s\n"
+		"Deregistrations: %2 msg/s\n"
+		"Coalesced: %3 msg/s\n"
+		"Unchanged: %4 msg/s\n"
+		"Filtered: %5 msg/s\n"
+		"Received: ~%6 bytes/s (estimated)" )
+			.arg( stat.messagesRate() )
+			.arg( stat.deregistrationsRate() )
+			.arg( stat.coalescedCount() )
+			.arg( stat.droppedCount() )
+			.arg( stat.filteredCount() )
+			.arg( stat.bytesRate() ) );
+
+	d->m_statLabel->setText( tr( "pending %1, latency %2/%3 ms" )
+		.arg( stat.pendingCount() )
+		.arg( stat.latencyP50() )
+		.arg( stat.latencyP99() ) );
 }
 
 void
@@ -313,6 +378,23 @@ ChannelWidget::disconnected()
 	d->m_reconnectButton->setEnabled( false );
 }
 
+void
+ChannelWidget::reconnectStateChanged( int attempt,
+	const QDateTime & nextAttempt )
+{
+	if( attempt > 0 && nextAttempt.isValid() )
+	{
+		d->m_reconnectLabel->setText( tr( "Reconnect #%1 at %2" )
+			.arg( attempt )
+			.arg( nextAttempt.time().toString( QLatin1String( "hh:mm:ss" ) ) ) );
+		d->m_reconnectLabel->show();
+	}
+	else
+		d->m_reconnectLabel->hide();
+
+	updateGeometry();
+}
+
 void
 ChannelWidget::connectButtonClicked()
 {
@@ -26,11 +26,13 @@
 // Qt include.
 #include <QWidget>
 #include <QScopedPointer>
+#include <QDateTime>
 
 
 namespace Globe {
 
 class Channel;
+class ChannelStatistics;
 class ChannelWidgetPrivate;
 
 //
@@ -58,18 +60,22 @@ public:
 	Channel * channel() const;
 
 public slots:
-	//! Set timeout.
+	//! Set timeout. c_autoTimeout turns on automatic timeout.
 	void setTimeout( int t );
 
 private slots:
 	//! Timeout was changed.
 	void timeoutChanged( int msecs );
-	//! New message rate.
-	void messageRate( int msgCount );
+	//! Automatic timeout was turned on/off.
+	void autoTimeoutChanged( bool on );
+	//! New statistics of the channel.
+	void statisticsUpdated( const Globe::ChannelStatistics & stat );
 	//! Channel connected.
 	void connected();
 	//! Channel disconnected.
 	void disconnected();
+	//! State of the reconnection changed.
+	void reconnectStateChanged( int attempt, const QDateTime & nextAttempt );
 	//! Connect button was clicked.
 	void connectButtonClicked();
 	//! Disconnect button clicked.
@@ -23,6 +23,7 @@
 // Globe include.
 #include <Core/channels.hpp>
 #include <Core/log.hpp>
+#include <Core/io_thread_pool.hpp>
 
 // Qt include.
 #include <QTimer>
@@ -37,6 +38,23 @@
 
 namespace Globe {
 
+//
+// ChannelPluginInterface
+//
+
+QThread *
+ChannelPluginInterface::acquireIOThread()
+{
+	return IOThreadPool::instance().acquireThread();
+}
+
+void
+ChannelPluginInterface::releaseIOThread( QThread * thread )
+{
+	IOThreadPool::instance().releaseThread( thread );
+}
+
+
 //
 // ChannelPrivate
 //
@@ -96,6 +114,12 @@ Channel::portNumber() const
 	return d->m_port;
 }
 
+const ChannelStatistics &
+Channel::statistics() const
+{
+	return d->m_statistics;
+}
+
 void
 Channel::connectToHost()
 {
@@ -120,6 +144,70 @@ Channel::updateTimeout( int msecs )
 	updateTimeoutImplementation( msecs );
 }
 
+void
+Channel::updateAutoTimeoutBounds( int minMsecs, int maxMsecs )
+{
+	updateAutoTimeoutBoundsImplementation( minMsecs, maxMsecs );
+}
+
+void
+Channel::updatePendingLimit( int limit )
+{
+	updatePendingLimitImplementation( limit );
+}
+
+void
+Channel::updateReconnectDelay( int minMsecs, int maxMsecs )
+{
+	updateReconnectDelayImplementation( minMsecs, maxMsecs );
+}
+
+void
+Channel::updateUrgentLevel( Level level )
+{
+	updateUrgentLevelImplementation( level );
+}
+
+void
+Channel::updateChangesOnly( bool on )
+{
+	updateChangesOnlyImplementation( on );
+}
+
+void
+Channel::updateFilter( const Globe::SourcesFilter & filter )
+{
+	updateFilterImplementation( filter );
+}
+
+void
+Channel::updateCaptureFile( const QString & fileName )
+{
+	updateCaptureFileImplementation( fileName );
+}
+
+void
+Channel::notifySourcesUpdated( const QVector< Como::Source > & sources )
+{
+	if( sources.isEmpty() )
+		return;
+
+	for( const auto & source : sources )
+		emit sourceUpdated( source );
+
+	emit sourcesUpdated( sources );
+}
+
+void
+Channel::notifyStatistics( const ChannelStatistics & stat )
+{
+	d->m_statistics = stat;
+
+	emit messagesRate( stat.messagesRate() );
+
+	emit statisticsUpdated( stat );
+}
+
 
 //
 // ChannelsManagerPrivate
@@ -365,14 +453,27 @@ ChannelsManager::supportedChannels() const
 }
 
 void
-ChannelsManager::shutdown()
+ChannelsManager::shutdown( int msecs )
 {
-	for( QMap< QString, Channel* >::ConstIterator it = d->m_channels.begin(),
-		last = d->m_channels.end(); it != last; ++it )
+	const QMap< QString, Channel* > channels = d->m_channels;
+
+	d->m_channels.clear();
+
+	for( QMap< QString, Channel* >::ConstIterator it = channels.begin(),
+		last = channels.end(); it != last; ++it )
 	{
 		it.value()->deactivate();
-		it.value()->deleteLater();
+
+		// Views drop the channel before it's deleted, since the
+		// nested event loop below still delivers timers to them.
+		emit channelRemoved( it.value() );
+
+		// Deferred deletion will not happen in the nested event loop
+		// below, so channels are deleted right here.
+		delete it.value();
 	}
+
+	IOThreadPool::instance().shutdown( msecs );
 }
 
 } /* namespace Globe */
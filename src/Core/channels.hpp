@@ -28,19 +28,32 @@
 #include <QScopedPointer>
 #include <QString>
 #include <QList>
+#include <QVector>
+#include <QDateTime>
 #include <QtPlugin>
 
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
 // Como include.
 #include <Como/Source>
 
 // Globe include.
 #include <Core/export.hpp>
+#include <Core/channel_statistics.hpp>
+#include <Core/adaptive_timeout.hpp>
+#include <Core/condition.hpp>
+#include <Core/sources_filter.hpp>
 
 
 namespace Globe {
 
 class Channel;
 
+//! Default level from which updates are delivered without timeout.
+static const Level c_defaultUrgentLevel = Critical;
+
 
 //
 // ChannelPluginInterface
@@ -61,6 +74,18 @@ public:
 
 	//! \return Channel type.
 	virtual QString channelType() const = 0;
+
+	/*!
+		\return Thread from the shared I/O thread pool for the
+		channel's socket.
+
+		Thread must be returned with releaseIOThread() when
+		the channel doesn't need it anymore. Thread must not be
+		stopped or deleted by the channel.
+	*/
+	static QThread * acquireIOThread();
+	//! Return thread to the shared I/O thread pool.
+	static void releaseIOThread( QThread * thread );
 }; // class ChannelPluginInterface
 
 
@@ -85,6 +110,8 @@ public:
 	QString m_address;
 	//! Port.
 	quint16 m_port;
+	//! Statistics for the last period.
+	ChannelStatistics m_statistics;
 }; // class ChannelPrivate
 
 
@@ -103,6 +130,13 @@ class CORE_EXPORT Channel
 signals:
 	//! New source or update.
 	void sourceUpdated( const Como::Source & );
+	/*!
+		New sources or updates.
+
+		Emitted once per flush of the channel with all
+		sources that were sent out with sourceUpdated().
+	*/
+	void sourcesUpdated( const QVector< Como::Source > & );
 	//! Source deregistered.
 	void sourceDeregistered( const Como::Source & );
 	//! Connected to host.
@@ -111,6 +145,18 @@ signals:
 	void disconnected();
 	//! Rate of the messages per second.
 	void messagesRate( int );
+	//! Statistics of the channel updated (once per second).
+	void statisticsUpdated( const Globe::ChannelStatistics & );
+	//! Timeout was changed by the channel in automatic mode.
+	void timeoutChanged( int msecs );
+	/*!
+		State of the reconnection changed.
+
+		\a attempt is the number of the scheduled attempt and
+		\a nextAttempt is the time of it. 0 and invalid time
+		mean that no reconnection is scheduled.
+	*/
+	void reconnectStateChanged( int attempt, const QDateTime & nextAttempt );
 
 public:
 	Channel(
@@ -129,8 +175,30 @@ public:
 	const QString & hostAddress() const;
 	//! \return Port.
 	quint16 portNumber() const;
-	//! \return Timeout in the channel.
+	//! \return Statistics of the channel for the last period.
+	const ChannelStatistics & statistics() const;
+	//! \return Timeout in the channel (current one in automatic mode).
 	virtual int timeout() const = 0;
+	//! \return Is timeout adjusted automatically.
+	virtual bool isAutoTimeout() const = 0;
+	//! \return Minimum of the automatic timeout in ms.
+	virtual int minAutoTimeout() const = 0;
+	//! \return Maximum of the automatic timeout in ms.
+	virtual int maxAutoTimeout() const = 0;
+	//! \return Limit of the pending sources in the channel.
+	virtual int pendingLimit() const = 0;
+	//! \return Minimum delay before reconnection in ms.
+	virtual int minReconnectDelay() const = 0;
+	//! \return Maximum delay before reconnection in ms.
+	virtual int maxReconnectDelay() const = 0;
+	//! \return Level from which updates are delivered without timeout.
+	virtual Level urgentLevel() const = 0;
+	//! \return Whether only changed values are delivered.
+	virtual bool isChangesOnly() const = 0;
+	//! \return Filter of the sources.
+	virtual const SourcesFilter & filter() const = 0;
+	//! \return File of the traffic capture, empty if capture is off.
+	virtual const QString & captureFile() const = 0;
 	//! \return Is channel in connected state.
 	virtual bool isConnected() const = 0;
 	//! \return Whether the user wants to make this channel connected.
@@ -152,10 +220,73 @@ public slots:
 		one in the given period then only one actual refresh will be
 		send out with the sourceUpdated() signal. It's very helpfull
 		for decreasing load of the application.
+
+		c_autoTimeout turns on automatic mode: timeout grows
+		under high load and shrinks back when load drops, within
+		bounds set with updateAutoTimeoutBounds().
 	*/
 	void updateTimeout(
 		//! Timeout in milliseconds.
 		int msecs );
+	//! Set bounds of the automatic timeout.
+	void updateAutoTimeoutBounds(
+		//! Minimum timeout in milliseconds.
+		int minMsecs,
+		//! Maximum timeout in milliseconds.
+		int maxMsecs );
+	/*!
+		Set limit of the sources waiting for the timeout.
+
+		When count of the pending sources reaches this limit
+		all of them will be sent out immediately. 0 means
+		no limit.
+	*/
+	void updatePendingLimit(
+		//! Maximum count of the pending sources.
+		int limit );
+	/*!
+		Set delays before reconnection.
+
+		When connection is lost channel will try to reconnect
+		after delay that exponentially grows from \a minMsecs
+		to \a maxMsecs with random jitter.
+	*/
+	void updateReconnectDelay(
+		//! Minimum delay in milliseconds.
+		int minMsecs,
+		//! Maximum delay in milliseconds.
+		int maxMsecs );
+	/*!
+		Set level from which updates are delivered without timeout.
+
+		Update of the source that has level evaluated with it's
+		properties at or above \a level (i.e. Critical is above
+		Error) is sent out immediately, bypassing the timeout.
+		None turns it off.
+	*/
+	void updateUrgentLevel( Level level );
+	/*!
+		Set whether only changed values are delivered.
+
+		When on, update with the same value and description as the
+		previous one of the source is dropped in the channel.
+	*/
+	void updateChangesOnly( bool on );
+	/*!
+		Set filter of the sources.
+
+		Updates and deregistrations of the sources that don't
+		pass the filter are dropped in the channel.
+	*/
+	void updateFilter( const Globe::SourcesFilter & filter );
+	/*!
+		Set file of the traffic capture.
+
+		Every received update and deregistration is appended to
+		\a fileName with the time of receiving, before filtering
+		and coalescing. Empty file name turns capture off.
+	*/
+	void updateCaptureFile( const QString & fileName );
 
 protected:
 	friend class ChannelsManager;
@@ -173,6 +304,38 @@ protected:
 	virtual void reconnectToHostImplementation() = 0;
 	//! Implementation of the "update timeout" operation.
 	virtual void updateTimeoutImplementation( int msecs ) = 0;
+	//! Implementation of the "update automatic timeout bounds" operation.
+	virtual void updateAutoTimeoutBoundsImplementation( int minMsecs,
+		int maxMsecs ) = 0;
+	//! Implementation of the "update pending limit" operation.
+	virtual void updatePendingLimitImplementation( int limit ) = 0;
+	//! Implementation of the "update reconnect delay" operation.
+	virtual void updateReconnectDelayImplementation( int minMsecs,
+		int maxMsecs ) = 0;
+	//! Implementation of the "update urgent level" operation.
+	virtual void updateUrgentLevelImplementation( Level level ) = 0;
+	//! Implementation of the "update changes only" operation.
+	virtual void updateChangesOnlyImplementation( bool on ) = 0;
+	//! Implementation of the "update filter" operation.
+	virtual void updateFilterImplementation( const SourcesFilter & filter ) = 0;
+	//! Implementation of the "update capture file" operation.
+	virtual void updateCaptureFileImplementation(
+		const QString & fileName ) = 0;
+
+	/*!
+		Send out updated sources.
+
+		Emits sourceUpdated() for each source and then
+		sourcesUpdated() with the whole batch.
+	*/
+	void notifySourcesUpdated( const QVector< Como::Source > & sources );
+
+	/*!
+		Store statistics for the last period.
+
+		Emits messagesRate() and statisticsUpdated().
+	*/
+	void notifyStatistics( const ChannelStatistics & stat );
 
 	Channel(
 		//! Channel private.
@@ -193,7 +356,7 @@ class ChannelsManagerPrivate;
 //
 
 //! Channel's manager.
-class ChannelsManager
+class CORE_EXPORT ChannelsManager
 	:	public QObject
 {
 	Q_OBJECT
@@ -264,8 +427,14 @@ public:
 	//! \return All supported types of channels.
 	QStringList supportedChannels() const;
 
-	//! Shutdown all channels.
-	void shutdown();
+	/*!
+		Shutdown all channels.
+
+		Channels are deleted immediately, and then their
+		teardown is awaited in the event loop no longer
+		than \a msecs milliseconds in total.
+	*/
+	void shutdown( int msecs = 3000 );
 
 private:
 	Q_DISABLE_COPY( ChannelsManager )
@@ -22,6 +22,8 @@
 
 // Globe include.
 #include <Core/channels_cfg.hpp>
+#include <Core/reconnect_policy.hpp>
+#include <Core/condition_cfg.hpp>
 
 
 namespace Globe {
@@ -34,6 +36,13 @@ ChannelCfg::ChannelCfg()
 	:	m_port( 0 )
 	,	m_isMustBeConnected( false )
 	,	m_timeout( 0 )
+	,	m_minAutoTimeout( c_defaultMinAutoTimeout )
+	,	m_maxAutoTimeout( c_defaultMaxAutoTimeout )
+	,	m_pendingLimit( 0 )
+	,	m_minReconnectDelay( c_defaultMinReconnectDelay )
+	,	m_maxReconnectDelay( c_defaultMaxReconnectDelay )
+	,	m_urgentLevel( c_defaultUrgentLevel )
+	,	m_isChangesOnly( false )
 {
 }
 
@@ -45,6 +54,13 @@ ChannelCfg::ChannelCfg( const QString & name, const QString & address,
 	,	m_port( port )
 	,	m_isMustBeConnected( isMustBeConnected )
 	,	m_timeout( timeout )
+	,	m_minAutoTimeout( c_defaultMinAutoTimeout )
+	,	m_maxAutoTimeout( c_defaultMaxAutoTimeout )
+	,	m_pendingLimit( 0 )
+	,	m_minReconnectDelay( c_defaultMinReconnectDelay )
+	,	m_maxReconnectDelay( c_defaultMaxReconnectDelay )
+	,	m_urgentLevel( c_defaultUrgentLevel )
+	,	m_isChangesOnly( false )
 	,	m_type( type )
 {
 }
@@ -55,6 +71,15 @@ ChannelCfg::ChannelCfg( const ChannelCfg & other )
 	,	m_port( other.port() )
 	,	m_isMustBeConnected( other.isMustBeConnected() )
 	,	m_timeout( other.timeout() )
+	,	m_minAutoTimeout( other.minAutoTimeout() )
+	,	m_maxAutoTimeout( other.maxAutoTimeout() )
+	,	m_pendingLimit( other.pendingLimit() )
+	,	m_minReconnectDelay( other.minReconnectDelay() )
+	,	m_maxReconnectDelay( other.maxReconnectDelay() )
+	,	m_urgentLevel( other.urgentLevel() )
+	,	m_isChangesOnly( other.isChangesOnly() )
+	,	m_filter( other.filter() )
+	,	m_captureFile( other.captureFile() )
 	,	m_type( other.channelType() )
 {
 }
@@ -69,6 +94,15 @@ ChannelCfg::operator = ( const ChannelCfg & other )
 		m_port = other.port();
 		m_isMustBeConnected = other.isMustBeConnected();
 		m_timeout = other.timeout();
+		m_minAutoTimeout = other.minAutoTimeout();
+		m_maxAutoTimeout = other.maxAutoTimeout();
+		m_pendingLimit = other.pendingLimit();
+		m_minReconnectDelay = other.minReconnectDelay();
+		m_maxReconnectDelay = other.maxReconnectDelay();
+		m_urgentLevel = other.urgentLevel();
+		m_isChangesOnly = other.isChangesOnly();
+		m_filter = other.filter();
+		m_captureFile = other.captureFile();
 		m_type = other.channelType();
 	}
 
@@ -136,6 +170,114 @@ ChannelCfg::setTimeout( int t )
 	m_timeout = t;
 }
 
+int
+ChannelCfg::minAutoTimeout() const
+{
+	return m_minAutoTimeout;
+}
+
+void
+ChannelCfg::setMinAutoTimeout( int t )
+{
+	m_minAutoTimeout = t;
+}
+
+int
+ChannelCfg::maxAutoTimeout() const
+{
+	return m_maxAutoTimeout;
+}
+
+void
+ChannelCfg::setMaxAutoTimeout( int t )
+{
+	m_maxAutoTimeout = t;
+}
+
+int
+ChannelCfg::pendingLimit() const
+{
+	return m_pendingLimit;
+}
+
+void
+ChannelCfg::setPendingLimit( int l )
+{
+	m_pendingLimit = l;
+}
+
+int
+ChannelCfg::minReconnectDelay() const
+{
+	return m_minReconnectDelay;
+}
+
+void
+ChannelCfg::setMinReconnectDelay( int d )
+{
+	m_minReconnectDelay = d;
+}
+
+int
+ChannelCfg::maxReconnectDelay() const
+{
+	return m_maxReconnectDelay;
+}
+
+void
+ChannelCfg::setMaxReconnectDelay( int d )
+{
+	m_maxReconnectDelay = d;
+}
+
+Level
+ChannelCfg::urgentLevel() const
+{
+	return m_urgentLevel;
+}
+
+void
+ChannelCfg::setUrgentLevel( Level l )
+{
+	m_urgentLevel = l;
+}
+
+bool
+ChannelCfg::isChangesOnly() const
+{
+	return m_isChangesOnly;
+}
+
+void
+ChannelCfg::setChangesOnly( bool on )
+{
+	m_isChangesOnly = on;
+}
+
+const SourcesFilter &
+ChannelCfg::filter() const
+{
+	return m_filter;
+}
+
+void
+ChannelCfg::setFilter( const SourcesFilter & f )
+{
+	m_filter = f;
+}
+
+const QString &
+ChannelCfg::captureFile() const
+{
+	return m_captureFile;
+}
+
+void
+ChannelCfg::setCaptureFile( const QString & fileName )
+{
+	m_captureFile = fileName;
+}
+
 const QString &
 ChannelCfg::channelType() const
 {
@@ -149,6 +291,37 @@ ChannelCfg::setChannelType( const QString & type )
 }
 
 
+//! Set \a patterns to the \a tag.
+static inline void setPatterns( PatternsTag & tag,
+	const QStringList & patterns, const QString & name )
+{
+	for( const QString & p : patterns )
+	{
+		PatternsTag::ptr_to_tag_t pattern(
+			new cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > (
+				name, true ) );
+
+		pattern->set_value( p );
+
+		tag.set_value( pattern );
+	}
+}
+
+//! \return Patterns from the \a tag.
+static inline QStringList patterns( const PatternsTag & tag )
+{
+	QStringList res;
+
+	if( tag.is_defined() )
+	{
+		for( std::size_t i = 0; i < tag.size(); ++i )
+			res.append( tag.at( i ).value() );
+	}
+
+	return res;
+}
+
+
 //
 // ChannelTag
 //
@@ -161,10 +334,37 @@ ChannelTag::ChannelTag( const QString & name, bool isMandatory )
 	,	m_isMustBeConnected( *this, QLatin1String( "mustBeConnected" ), false )
 	,	m_timeout( *this, QLatin1String( "timeout" ), false )
 	,	m_timeoutConstraint( 0, 10000 )
+	,	m_autoTimeout( *this, QLatin1String( "autoTimeout" ), false )
+	,	m_minAutoTimeout( *this, QLatin1String( "minAutoTimeout" ), false )
+	,	m_maxAutoTimeout( *this, QLatin1String( "maxAutoTimeout" ), false )
+	,	m_pendingLimit( *this, QLatin1String( "pendingLimit" ), false )
+	,	m_pendingLimitConstraint( 0, 1000000 )
+	,	m_minReconnectDelay( *this, QLatin1String( "minReconnectDelay" ), false )
+	,	m_maxReconnectDelay( *this, QLatin1String( "maxReconnectDelay" ), false )
+	,	m_reconnectDelayConstraint( 1, 3600000 )
+	,	m_urgentLevel( *this, QLatin1String( "urgentLevel" ), false )
+	,	m_changesOnly( *this, QLatin1String( "changesOnly" ), false )
+	,	m_include( *this, QLatin1String( "include" ), false )
+	,	m_exclude( *this, QLatin1String( "exclude" ), false )
+	,	m_captureFile( *this, QLatin1String( "captureFile" ), false )
 	,	m_type( *this, QLatin1String( "type" ), true )
 {
+	m_urgentLevelConstraint.add_value( criticalLevelString );
+	m_urgentLevelConstraint.add_value( errorLevelString );
+	m_urgentLevelConstraint.add_value( warningLevelString );
+	m_urgentLevelConstraint.add_value( debugLevelString );
+	m_urgentLevelConstraint.add_value( infoLevelString );
+	m_urgentLevelConstraint.add_value( noneLevelString );
+
+	m_urgentLevel.set_constraint( &m_urgentLevelConstraint );
+
 	m_port.set_constraint( &m_portConstraint );
 	m_timeout.set_constraint( &m_timeoutConstraint );
+	m_minAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_maxAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_pendingLimit.set_constraint( &m_pendingLimitConstraint );
+	m_minReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
+	m_maxReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
 }
 
 ChannelTag::ChannelTag( cfgfile::tag_t< cfgfile::qstring_trait_t > & owner,
@@ -176,10 +376,37 @@ ChannelTag::ChannelTag( cfgfile::tag_t< cfgfile::qstring_trait_t > & owner,
 	,	m_isMustBeConnected( *this, QLatin1String( "mustBeConnected" ), false )
 	,	m_timeout( *this, QLatin1String( "timeout" ), false )
 	,	m_timeoutConstraint( 0, 10000 )
+	,	m_autoTimeout( *this, QLatin1String( "autoTimeout" ), false )
+	,	m_minAutoTimeout( *this, QLatin1String( "minAutoTimeout" ), false )
+	,	m_maxAutoTimeout( *this, QLatin1String( "maxAutoTimeout" ), false )
+	,	m_pendingLimit( *this, QLatin1String( "pendingLimit" ), false )
+	,	m_pendingLimitConstraint( 0, 1000000 )
+	,	m_minReconnectDelay( *this, QLatin1String( "minReconnectDelay" ), false )
+	,	m_maxReconnectDelay( *this, QLatin1String( "maxReconnectDelay" ), false )
+	,	m_reconnectDelayConstraint( 1, 3600000 )
+	,	m_urgentLevel( *this, QLatin1String( "urgentLevel" ), false )
+	,	m_changesOnly( *this, QLatin1String( "changesOnly" ), false )
+	,	m_include( *this, QLatin1String( "include" ), false )
+	,	m_exclude( *this, QLatin1String( "exclude" ), false )
+	,	m_captureFile( *this, QLatin1String( "captureFile" ), false )
 	,	m_type( *this, QLatin1String( "type" ), true )
 {
+	m_urgentLevelConstraint.add_value( criticalLevelString );
+	m_urgentLevelConstraint.add_value( errorLevelString );
+	m_urgentLevelConstraint.add_value( warningLevelString );
+	m_urgentLevelConstraint.add_value( debugLevelString );
+	m_urgentLevelConstraint.add_value( infoLevelString );
+	m_urgentLevelConstraint.add_value( noneLevelString );
+
+	m_urgentLevel.set_constraint( &m_urgentLevelConstraint );
+
 	m_port.set_constraint( &m_portConstraint );
 	m_timeout.set_constraint( &m_timeoutConstraint );
+	m_minAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_maxAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_pendingLimit.set_constraint( &m_pendingLimitConstraint );
+	m_minReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
+	m_maxReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
 }
 
 ChannelTag::ChannelTag( const ChannelCfg & cfg,
@@ -192,10 +419,37 @@ ChannelTag::ChannelTag( const ChannelCfg & cfg,
 	,	m_isMustBeConnected( *this, QLatin1String( "mustBeConnected" ), false )
 	,	m_timeout( *this, QLatin1String( "timeout" ), false )
 	,	m_timeoutConstraint( 0, 10000 )
+	,	m_autoTimeout( *this, QLatin1String( "autoTimeout" ), false )
+	,	m_minAutoTimeout( *this, QLatin1String( "minAutoTimeout" ), false )
+	,	m_maxAutoTimeout( *this, QLatin1String( "maxAutoTimeout" ), false )
+	,	m_pendingLimit( *this, QLatin1String( "pendingLimit" ), false )
+	,	m_pendingLimitConstraint( 0, 1000000 )
+	,	m_minReconnectDelay( *this, QLatin1String( "minReconnectDelay" ), false )
+	,	m_maxReconnectDelay( *this, QLatin1String( "maxReconnectDelay" ), false )
+	,	m_reconnectDelayConstraint( 1, 3600000 )
+	,	m_urgentLevel( *this, QLatin1String( "urgentLevel" ), false )
+	,	m_changesOnly( *this, QLatin1String( "changesOnly" ), false )
+	,	m_include( *this, QLatin1String( "include" ), false )
+	,	m_exclude( *this, QLatin1String( "exclude" ), false )
+	,	m_captureFile( *this, QLatin1String( "captureFile" ), false )
 	,	m_type( *this, QLatin1String( "type" ), true )
 {
+	m_urgentLevelConstraint.add_value( criticalLevelString );
+	m_urgentLevelConstraint.add_value( errorLevelString );
+	m_urgentLevelConstraint.add_value( warningLevelString );
+	m_urgentLevelConstraint.add_value( debugLevelString );
+	m_urgentLevelConstraint.add_value( infoLevelString );
+	m_urgentLevelConstraint.add_value( noneLevelString );
+
+	m_urgentLevel.set_constraint( &m_urgentLevelConstraint );
+
 	m_port.set_constraint( &m_portConstraint );
 	m_timeout.set_constraint( &m_timeoutConstraint );
+	m_minAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_maxAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_pendingLimit.set_constraint( &m_pendingLimitConstraint );
+	m_minReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
+	m_maxReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
 
 	set_value( cfg.name() );
 	m_address.set_value( cfg.address() );
@@ -205,8 +459,37 @@ ChannelTag::ChannelTag( const ChannelCfg & cfg,
 	if( cfg.isMustBeConnected() )
 		m_isMustBeConnected.set_defined();
 
-	if( cfg.timeout() )
+	if( cfg.timeout() == c_autoTimeout )
+		m_autoTimeout.set_defined();
+	else if( cfg.timeout() )
 		m_timeout.set_value( cfg.timeout() );
+
+	if( cfg.minAutoTimeout() != c_defaultMinAutoTimeout )
+		m_minAutoTimeout.set_value( cfg.minAutoTimeout() );
+
+	if( cfg.maxAutoTimeout() != c_defaultMaxAutoTimeout )
+		m_maxAutoTimeout.set_value( cfg.maxAutoTimeout() );
+
+	if( cfg.pendingLimit() )
+		m_pendingLimit.set_value( cfg.pendingLimit() );
+
+	if( cfg.minReconnectDelay() != c_defaultMinReconnectDelay )
+		m_minReconnectDelay.set_value( cfg.minReconnectDelay() );
+
+	if( cfg.maxReconnectDelay() != c_defaultMaxReconnectDelay )
+		m_maxReconnectDelay.set_value( cfg.maxReconnectDelay() );
+
+	if( cfg.urgentLevel() != c_defaultUrgentLevel )
+		m_urgentLevel.set_value( levelToString( cfg.urgentLevel() ) );
+
+	if( cfg.isChangesOnly() )
+		m_changesOnly.set_defined();
+
+	setPatterns( m_include, cfg.filter().include(), QLatin1String( "include" ) );
+	setPatterns( m_exclude, cfg.filter().exclude(), QLatin1String( "exclude" ) );
+
+	if( !cfg.captureFile().isEmpty() )
+		m_captureFile.set_value( cfg.captureFile() );
 }
 
 ChannelTag::ChannelTag( const ChannelCfg & cfg,
@@ -218,10 +501,37 @@ ChannelTag::ChannelTag( const ChannelCfg & cfg,
 	,	m_isMustBeConnected( *this, QLatin1String( "mustBeConnected" ), false )
 	,	m_timeout( *this, QLatin1String( "timeout" ), false )
 	,	m_timeoutConstraint( 0, 10000 )
+	,	m_autoTimeout( *this, QLatin1String( "autoTimeout" ), false )
+	,	m_minAutoTimeout( *this, QLatin1String( "minAutoTimeout" ), false )
+	,	m_maxAutoTimeout( *this, QLatin1String( "maxAutoTimeout" ), false )
+	,	m_pendingLimit( *this, QLatin1String( "pendingLimit" ), false )
+	,	m_pendingLimitConstraint( 0, 1000000 )
+	,	m_minReconnectDelay( *this, QLatin1String( "minReconnectDelay" ), false )
+	,	m_maxReconnectDelay( *this, QLatin1String( "maxReconnectDelay" ), false )
+	,	m_reconnectDelayConstraint( 1, 3600000 )
+	,	m_urgentLevel( *this, QLatin1String( "urgentLevel" ), false )
+	,	m_changesOnly( *this, QLatin1String( "changesOnly" ), false )
+	,	m_include( *this, QLatin1String( "include" ), false )
+	,	m_exclude( *this, QLatin1String( "exclude" ), false )
+	,	m_captureFile( *this, QLatin1String( "captureFile" ), false )
 	,	m_type( *this, QLatin1String( "type" ), true )
 {
+	m_urgentLevelConstraint.add_value( criticalLevelString );
+	m_urgentLevelConstraint.add_value( errorLevelString );
+	m_urgentLevelConstraint.add_value( warningLevelString );
+	m_urgentLevelConstraint.add_value( debugLevelString );
+	m_urgentLevelConstraint.add_value( infoLevelString );
+	m_urgentLevelConstraint.add_value( noneLevelString );
+
+	m_urgentLevel.set_constraint( &m_urgentLevelConstraint );
+
 	m_port.set_constraint( &m_portConstraint );
 	m_timeout.set_constraint( &m_timeoutConstraint );
+	m_minAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_maxAutoTimeout.set_constraint( &m_timeoutConstraint );
+	m_pendingLimit.set_constraint( &m_pendingLimitConstraint );
+	m_minReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
+	m_maxReconnectDelay.set_constraint( &m_reconnectDelayConstraint );
 
 	set_value( cfg.name() );
 	m_address.set_value( cfg.address() );
@@ -231,8 +541,37 @@ ChannelTag::ChannelTag( const ChannelCfg & cfg,
 	if( cfg.isMustBeConnected() )
 		m_isMustBeConnected.set_defined();
 
-	if( cfg.timeout() )
+	if( cfg.timeout() == c_autoTimeout )
+		m_autoTimeout.set_defined();
+	else if( cfg.timeout() )
 		m_timeout.set_value( cfg.timeout() );
+
+	if( cfg.minAutoTimeout() != c_defaultMinAutoTimeout )
+		m_minAutoTimeout.set_value( cfg.minAutoTimeout() );
+
+	if( cfg.maxAutoTimeout() != c_defaultMaxAutoTimeout )
+		m_maxAutoTimeout.set_value( cfg.maxAutoTimeout() );
+
+	if( cfg.pendingLimit() )
+		m_pendingLimit.set_value( cfg.pendingLimit() );
+
+	if( cfg.minReconnectDelay() != c_defaultMinReconnectDelay )
+		m_minReconnectDelay.set_value( cfg.minReconnectDelay() );
+
+	if( cfg.maxReconnectDelay() != c_defaultMaxReconnectDelay )
+		m_maxReconnectDelay.set_value( cfg.maxReconnectDelay() );
+
+	if( cfg.urgentLevel() != c_defaultUrgentLevel )
+		m_urgentLevel.set_value( levelToString( cfg.urgentLevel() ) );
+
+	if( cfg.isChangesOnly() )
+		m_changesOnly.set_defined();
+
+	setPatterns( m_include, cfg.filter().include(), QLatin1String( "include" ) );
+	setPatterns( m_exclude, cfg.filter().exclude(), QLatin1String( "exclude" ) );
+
+	if( !cfg.captureFile().isEmpty() )
+		m_captureFile.set_value( cfg.captureFile() );
 }
 
 ChannelTag::~ChannelTag()
@@ -249,9 +588,37 @@ ChannelTag::cfg() const
 	cfg.setPort( (quint16) m_port.value() );
 	cfg.setMustBeConnected( m_isMustBeConnected.is_defined() );
 
-	if( m_timeout.is_defined() )
+	if( m_autoTimeout.is_defined() )
+		cfg.setTimeout( c_autoTimeout );
+	else if( m_timeout.is_defined() )
 		cfg.setTimeout( m_timeout.value() );
 
+	if( m_minAutoTimeout.is_defined() )
+		cfg.setMinAutoTimeout( m_minAutoTimeout.value() );
+
+	if( m_maxAutoTimeout.is_defined() )
+		cfg.setMaxAutoTimeout( m_maxAutoTimeout.value() );
+
+	if( m_pendingLimit.is_defined() )
+		cfg.setPendingLimit( m_pendingLimit.value() );
+
+	if( m_minReconnectDelay.is_defined() )
+		cfg.setMinReconnectDelay( m_minReconnectDelay.value() );
+
+	if( m_maxReconnectDelay.is_defined() )
+		cfg.setMaxReconnectDelay( m_maxReconnectDelay.value() );
+
+	if( m_urgentLevel.is_defined() )
+		cfg.setUrgentLevel( levelFromString( m_urgentLevel.value() ) );
+
+	cfg.setChangesOnly( m_changesOnly.is_defined() );
+
+	cfg.setFilter( SourcesFilter( patterns( m_include ),
+		patterns( m_exclude ) ) );
+
+	if( m_captureFile.is_defined() )
+		cfg.setCaptureFile( m_captureFile.value() );
+
 	cfg.setChannelType( m_type.value() );
 
 	return cfg;
@@ -73,11 +73,56 @@ public:
 	//! Set whether the channel must be connected.
 	void setMustBeConnected( bool on = true );
 
-	//! \return Timeout in the channel.
+	//! \return Timeout in the channel (c_autoTimeout in automatic mode).
 	int timeout() const;
 	//! Set timeout in the channel.
 	void setTimeout( int t );
 
+	//! \return Minimum of the automatic timeout in ms.
+	int minAutoTimeout() const;
+	//! Set minimum of the automatic timeout in ms.
+	void setMinAutoTimeout( int t );
+
+	//! \return Maximum of the automatic timeout in ms.
+	int maxAutoTimeout() const;
+	//! Set maximum of the automatic timeout in ms.
+	void setMaxAutoTimeout( int t );
+
+	//! \return Limit of the pending sources in the channel.
+	int pendingLimit() const;
+	//! Set limit of the pending sources in the channel.
+	void setPendingLimit( int l );
+
+	//! \return Minimum delay before reconnection in ms.
+	int minReconnectDelay() const;
+	//! Set minimum delay before reconnection in ms.
+	void setMinReconnectDelay( int d );
+
+	//! \return Maximum delay before reconnection in ms.
+	int maxReconnectDelay() const;
+	//! Set maximum delay before reconnection in ms.
+	void setMaxReconnectDelay( int d );
+
+	//! \return Level from which updates are delivered without timeout.
+	Level urgentLevel() const;
+	//! Set level from which updates are delivered without timeout.
+	void setUrgentLevel( Level l );
+
+	//! \return Whether only changed values are delivered.
+	bool isChangesOnly() const;
+	//! Set whether only changed values are delivered.
+	void setChangesOnly( bool on = true );
+
+	//! \return Filter of the sources.
+	const SourcesFilter & filter() const;
+	//! Set filter of the sources.
+	void setFilter( const SourcesFilter & f );
+
+	//! \return File of the traffic capture, empty if capture is off.
+	const QString & captureFile() const;
+	//! Set file of the traffic capture.
+	void setCaptureFile( const QString & fileName );
+
 	//! \return Type of the channel.
 	const QString & channelType() const;
 	//! Set channel's type.
@@ -94,6 +139,24 @@ private:
 	bool m_isMustBeConnected;
 	//! Timeout in the channel.
 	int m_timeout;
+	//! Minimum of the automatic timeout.
+	int m_minAutoTimeout;
+	//! Maximum of the automatic timeout.
+	int m_maxAutoTimeout;
+	//! Limit of the pending sources in the channel.
+	int m_pendingLimit;
+	//! Minimum delay before reconnection.
+	int m_minReconnectDelay;
+	//! Maximum delay before reconnection.
+	int m_maxReconnectDelay;
+	//! Level from which updates are delivered without timeout.
+	Level m_urgentLevel;
+	//! Whether only changed values are delivered.
+	bool m_isChangesOnly;
+	//! Filter of the sources.
+	SourcesFilter m_filter;
+	//! File of the traffic capture.
+	QString m_captureFile;
 	//! Type of the channel.
 	QString m_type;
 }; // class ChannelCfg
@@ -103,6 +166,11 @@ private:
 typedef QList< ChannelCfg > AvailableChannelsCfg;
 
 
+//! Tag with patterns of the sources.
+typedef cfgfile::tag_vector_of_tags_t< cfgfile::tag_scalar_t< QString,
+	cfgfile::qstring_trait_t >, cfgfile::qstring_trait_t > PatternsTag;
+
+
 //
 // ChannelTag
 //
@@ -142,6 +210,34 @@ private:
 	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_timeout;
 	//! Consatrint for the timeout.
 	cfgfile::constraint_min_max_t< int > m_timeoutConstraint;
+	//! Whether the timeout is automatic.
+	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > m_autoTimeout;
+	//! Minimum of the automatic timeout.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_minAutoTimeout;
+	//! Maximum of the automatic timeout.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_maxAutoTimeout;
+	//! Limit of the pending sources in the channel.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_pendingLimit;
+	//! Constraint for the limit of the pending sources.
+	cfgfile::constraint_min_max_t< int > m_pendingLimitConstraint;
+	//! Minimum delay before reconnection.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_minReconnectDelay;
+	//! Maximum delay before reconnection.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_maxReconnectDelay;
+	//! Constraint for the delays before reconnection.
+	cfgfile::constraint_min_max_t< int > m_reconnectDelayConstraint;
+	//! Level from which updates are delivered without timeout.
+	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_urgentLevel;
+	//! Constraint for the urgent level.
+	cfgfile::constraint_one_of_t< QString > m_urgentLevelConstraint;
+	//! Whether only changed values are delivered.
+	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > m_changesOnly;
+	//! Include patterns of the sources.
+	PatternsTag m_include;
+	//! Exclude patterns of the sources.
+	PatternsTag m_exclude;
+	//! File of the traffic capture.
+	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_captureFile;
 	//! Channel's type.
 	cfgfile::tag_scalar_t< QString, cfgfile::qstring_trait_t > m_type;
 }; // class ChannelTag
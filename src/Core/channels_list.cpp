@@ -27,6 +27,7 @@
 #include <Core/channel_attributes.hpp>
 #include <Core/mainwindow.hpp>
 #include <Core/log.hpp>
+#include <Core/configuration.hpp>
 
 // Qt include.
 #include <QList>
@@ -37,6 +38,7 @@
 #include <QIcon>
 #include <QMenu>
 #include <QMessageBox>
+#include <QFileDialog>
 
 
 namespace Globe {
@@ -261,6 +263,10 @@ public:
 	QAction * m_delChannelAction;
 	//! Show channel view.
 	QAction * m_showChannelViewAction;
+	//! Edit filter of the channel.
+	QAction * m_editChannelFilterAction;
+	//! Start/stop traffic capture of the channel.
+	QAction * m_captureTrafficAction;
 	//! Index of current ChannelWidget.
 	int m_currentWidgetIndex;
 }; // class ChannelsListPrivate
@@ -292,6 +298,9 @@ ChannelsList::init()
 	d->m_delChannelAction = new QAction( QIcon( ":/img/remove_22x22.png" ),
 		tr( "Delete Channel" ), this );
 	d->m_showChannelViewAction = new QAction( tr( "Show Channel View" ), this );
+	d->m_editChannelFilterAction = new QAction( tr( "Edit Sources Filter" ),
+		this );
+	d->m_captureTrafficAction = new QAction( this );
 
 	connect( d->m_channelsToShowWidget, &ChannelsToShow::displayAllChannels,
 		this, &ChannelsList::showAll );
@@ -308,6 +317,13 @@ ChannelsList::init()
 		this, &ChannelsList::delChannel );
 	connect( d->m_showChannelViewAction, &QAction::triggered,
 		this, &ChannelsList::showChannelView );
+	connect( d->m_editChannelFilterAction, &QAction::triggered,
+		this, &ChannelsList::editChannelFilter );
+	connect( d->m_captureTrafficAction, &QAction::triggered,
+		this, &ChannelsList::captureTraffic );
+
+	connect( &ChannelsManager::instance(), &ChannelsManager::channelRemoved,
+		this, &ChannelsList::removeChannel );
 }
 
 void
@@ -375,17 +391,18 @@ ChannelsList::removeChannel( Channel * channel )
 {
 	if( channel )
 	{
-		disconnect( channel, 0, 0, 0 );
-
 		const ChannelWidgetAndLine & w = d->findWidget( channel );
 
 		if( w.widget() )
 		{
+			disconnect( channel, 0, w.widget(), 0 );
+
 			w.widget()->hide();
 			w.line()->hide();
-			d->m_widgets.removeOne( w );
 			w.widget()->deleteLater();
 			w.line()->deleteLater();
+			d->m_widgets.removeOne( w );
+			d->m_currentWidgetIndex = -1;
 			d->updateWidgetsPosition();
 		}
 	}
@@ -416,6 +433,15 @@ ChannelsList::contextMenuEvent( QContextMenuEvent * event )
 		menu.addAction( d->m_delChannelAction );
 		menu.addSeparator();
 		menu.addAction( d->m_showChannelViewAction );
+		menu.addAction( d->m_editChannelFilterAction );
+
+		if( d->m_widgets.at( d->m_currentWidgetIndex ).widget()->channel()->
+			captureFile().isEmpty() )
+				d->m_captureTrafficAction->setText( tr( "Capture Traffic..." ) );
+		else
+			d->m_captureTrafficAction->setText( tr( "Stop Traffic Capture" ) );
+
+		menu.addAction( d->m_captureTrafficAction );
 	}
 
 	menu.exec( event->globalPos() );
@@ -586,7 +612,12 @@ ChannelsList::addChannel()
 				attributes.type() );
 
 			if( channel )
+			{
+				channel->updateFilter( SourcesFilter( attributes.include(),
+					attributes.exclude() ) );
+
 				addChannel( channel, 0 );
+			}
 			else
 			{
 				Log::instance().writeMsgToEventLog( LogLevelError,
@@ -630,18 +661,63 @@ ChannelsList::delChannel()
 					.arg( widgetAndLine.widget()->channel()->name() ) )
 			== QMessageBox::Yes )
 		{
+			// Widget is removed on ChannelsManager::channelRemoved().
 			ChannelsManager::instance().removeChannel(
 				widgetAndLine.widget()->channel()->name() );
+		}
+	}
+}
 
-			widgetAndLine.widget()->hide();
-			widgetAndLine.line()->hide();
-			widgetAndLine.widget()->deleteLater();
-			widgetAndLine.line()->deleteLater();
+void
+ChannelsList::editChannelFilter()
+{
+	if( d->m_currentWidgetIndex != -1 )
+	{
+		Channel * channel =
+			d->m_widgets.at( d->m_currentWidgetIndex ).widget()->channel();
 
-			d->m_widgets.removeAt( d->m_currentWidgetIndex );
-			d->m_currentWidgetIndex = -1;
+		d->m_currentWidgetIndex = -1;
 
-			d->updateWidgetsPosition();
+		ChannelAttributes attributes;
+		attributes.setName( channel->name() );
+		attributes.setAddress( channel->hostAddress() );
+		attributes.setPort( channel->portNumber() );
+		attributes.setType( channel->channelType() );
+		attributes.setInclude( channel->filter().include() );
+		attributes.setExclude( channel->filter().exclude() );
+
+		ChannelAttributesDialog dlg( attributes,
+			QStringList() << channel->channelType(), this );
+
+		if( QDialog::Accepted == dlg.exec() )
+			channel->updateFilter( SourcesFilter( attributes.include(),
+				attributes.exclude() ) );
+	}
+}
+
+void
+ChannelsList::captureTraffic()
+{
+	if( d->m_currentWidgetIndex != -1 )
+	{
+		Channel * channel =
+			d->m_widgets.at( d->m_currentWidgetIndex ).widget()->channel();
+
+		d->m_currentWidgetIndex = -1;
+
+		if( !channel->captureFile().isEmpty() )
+			channel->updateCaptureFile( QString() );
+		else
+		{
+			const QString fileName = QFileDialog::getSaveFileName( this,
+				tr( "Capture Traffic" ),
+				Configuration::instance().path() + channel->name() +
+					QLatin1String( ".capture" ),
+				tr( "Traffic Capture (*.capture)" ), 0,
+				QFileDialog::DontConfirmOverwrite );
+
+			if( !fileName.isEmpty() )
+				channel->updateCaptureFile( fileName );
 		}
 	}
 }
@@ -94,6 +94,10 @@ private slots:
 	void addChannel();
 	//! Delete channel.
 	void delChannel();
+	//! Edit filter of the sources in the channel.
+	void editChannelFilter();
+	//! Start or stop traffic capture of the channel.
+	void captureTraffic();
 	//! Show channel view.
 	void showChannelView();
 
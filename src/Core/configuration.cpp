@@ -42,6 +42,9 @@
 #include <Core/sounds_disabled.hpp>
 #include <Core/db_cfg.hpp>
 #include <Core/utils.hpp>
+#include <Core/io_thread_pool.hpp>
+#include <Core/sources.hpp>
+#include <Core/sources_snapshot.hpp>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -157,6 +160,12 @@ Configuration::loadConfiguration()
 
 	readAppCfg( d->m_cfgFileName );
 
+	IOThreadPool::instance().setThreadsCount( d->m_appCfg.ioThreadsCount() );
+
+	SourcesManager::instance().setRetentionPolicy(
+		d->m_appCfg.deregisteredSourcesMaxAge(),
+		d->m_appCfg.deregisteredSourcesMaxCount() );
+
 	readDbCfg( d->m_appCfg.dbCfgFile() );
 
 	readLogCfg( d->m_appCfg.logCfgFile() );
@@ -177,8 +186,21 @@ Configuration::loadConfiguration()
 
 	readDisabledSoundsCfg( d->m_appCfg.disabledSoundsCfgFile() );
 
+	// Sources should be restored before channels and views are created.
+	if( !d->m_appCfg.sourcesSnapshotFile().isEmpty() )
+	{
+		SourcesSnapshot::instance().setFileName(
+			path() + d->m_appCfg.sourcesSnapshotFile(),
+			d->m_appCfg.sourcesSnapshotInterval() );
+
+		SourcesSnapshot::instance().read();
+	}
+
 	readChannelsCfg( d->m_appCfg.channelsCfgFile() );
 
+	// Channels from the snapshot that are no longer configured.
+	SourcesManager::instance().removeOrphanedChannels();
+
 	readWindowsCfg( d->m_appCfg.windowsCfgFile() );
 
 	if( d->m_appCfgWasLoaded )
@@ -479,8 +501,24 @@ Configuration::readChannelsCfg( const QString & cfgFileName )
 
 		if( channel )
 		{
+			channel->updateAutoTimeoutBounds( channelCfg.minAutoTimeout(),
+				channelCfg.maxAutoTimeout() );
+
 			MainWindow::instance().list()->addChannel( channel, channelCfg.timeout() );
 
+			channel->updatePendingLimit( channelCfg.pendingLimit() );
+
+			channel->updateReconnectDelay( channelCfg.minReconnectDelay(),
+				channelCfg.maxReconnectDelay() );
+
+			channel->updateUrgentLevel( channelCfg.urgentLevel() );
+
+			channel->updateChangesOnly( channelCfg.isChangesOnly() );
+
+			channel->updateFilter( channelCfg.filter() );
+
+			channel->updateCaptureFile( channelCfg.captureFile() );
+
 			if( channelCfg.isMustBeConnected() )
 				channel->connectToHost();
 		}
@@ -994,7 +1032,17 @@ Configuration::saveChannelsCfg( const QString & cfgFileName )
 		chCfg.setAddress( channel->hostAddress() );
 		chCfg.setPort( channel->portNumber() );
 		chCfg.setMustBeConnected( channel->isMustBeConnected() );
-		chCfg.setTimeout( channel->timeout() );
+		chCfg.setTimeout( channel->isAutoTimeout() ? c_autoTimeout :
+			channel->timeout() );
+		chCfg.setMinAutoTimeout( channel->minAutoTimeout() );
+		chCfg.setMaxAutoTimeout( channel->maxAutoTimeout() );
+		chCfg.setPendingLimit( channel->pendingLimit() );
+		chCfg.setMinReconnectDelay( channel->minReconnectDelay() );
+		chCfg.setMaxReconnectDelay( channel->maxReconnectDelay() );
+		chCfg.setUrgentLevel( channel->urgentLevel() );
+		chCfg.setChangesOnly( channel->isChangesOnly() );
+		chCfg.setFilter( channel->filter() );
+		chCfg.setCaptureFile( channel->captureFile() );
 		chCfg.setChannelType( channel->channelType() );
 
 		channelsCfg.append( chCfg );
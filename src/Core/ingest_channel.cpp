@@ -0,0 +1,402 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/ingest_channel.hpp>
+#include <Core/sources_coalescer.hpp>
+#include <Core/properties_manager.hpp>
+
+// Qt include.
+#include <QTimer>
+
+
+namespace Globe {
+
+//
+// IngestChannelPrivate
+//
+
+IngestChannelPrivate::IngestChannelPrivate( IngestChannel * parent,
+	const QString & name,
+	const QString & address,
+	quint16 port,
+	QThread * thread )
+	:	ChannelPrivate( parent, name, address, port )
+	,	m_thread( thread )
+	,	m_coalescer( 0 )
+	,	m_rateTimer( 0 )
+	,	m_updateTimeout( 0 )
+	,	m_isAutoTimeout( false )
+	,	m_pendingLimit( 0 )
+	,	m_urgentLevel( c_defaultUrgentLevel )
+	,	m_isChangesOnly( false )
+	,	m_isConnected( false )
+	,	m_isDisconnectedByUser( true )
+{
+}
+
+IngestChannelPrivate::~IngestChannelPrivate()
+{
+}
+
+
+//
+// IngestChannel
+//
+
+IngestChannel::IngestChannel( IngestChannelPrivate * dd )
+	:	Channel( dd )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_rateTimer = new QTimer( this );
+
+	connect( d->m_rateTimer, &QTimer::timeout,
+		this, &IngestChannel::updateStatistics );
+
+	d->m_rateTimer->start( 1000 );
+}
+
+IngestChannel::~IngestChannel()
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_rateTimer->stop();
+}
+
+void
+IngestChannel::initCoalescer( QObject * producer )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_coalescer = new SourcesCoalescer( d->m_name, producer );
+
+	connect( this, &IngestChannel::aboutToUpdateTimeout,
+		d->m_coalescer, &SourcesCoalescer::setTimeout,
+		Qt::QueuedConnection );
+
+	connect( this, &IngestChannel::aboutToUpdatePendingLimit,
+		d->m_coalescer, &SourcesCoalescer::setPendingLimit,
+		Qt::QueuedConnection );
+
+	connect( this, &IngestChannel::aboutToUpdateUrgentLevel,
+		d->m_coalescer, &SourcesCoalescer::setUrgentLevel,
+		Qt::QueuedConnection );
+
+	connect( this, &IngestChannel::aboutToUpdateChangesOnly,
+		d->m_coalescer, &SourcesCoalescer::setChangesOnly,
+		Qt::QueuedConnection );
+
+	connect( this, &IngestChannel::aboutToUpdateFilter,
+		d->m_coalescer, &SourcesCoalescer::setFilter,
+		Qt::QueuedConnection );
+
+	connect( this, &IngestChannel::aboutToUpdateCaptureFile,
+		d->m_coalescer, &SourcesCoalescer::setCaptureFile,
+		Qt::QueuedConnection );
+
+	connect( &PropertiesManager::instance(),
+		&PropertiesManager::propertiesChanged,
+		d->m_coalescer, &SourcesCoalescer::resetGroups,
+		Qt::QueuedConnection );
+
+	connect( d->m_coalescer, &SourcesCoalescer::sourcesReady,
+		this, &IngestChannel::sourcesHaveUpdatedValue,
+		Qt::QueuedConnection );
+
+	connect( d->m_coalescer, &SourcesCoalescer::sourceDeregistered,
+		this, &IngestChannel::sourceHasDeregistered,
+		Qt::QueuedConnection );
+}
+
+int
+IngestChannel::timeout() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_updateTimeout;
+}
+
+bool
+IngestChannel::isAutoTimeout() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_isAutoTimeout;
+}
+
+int
+IngestChannel::minAutoTimeout() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_adaptiveTimeout.minTimeout();
+}
+
+int
+IngestChannel::maxAutoTimeout() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_adaptiveTimeout.maxTimeout();
+}
+
+int
+IngestChannel::pendingLimit() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_pendingLimit;
+}
+
+int
+IngestChannel::minReconnectDelay() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_reconnectPolicy.minDelay();
+}
+
+int
+IngestChannel::maxReconnectDelay() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_reconnectPolicy.maxDelay();
+}
+
+Level
+IngestChannel::urgentLevel() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_urgentLevel;
+}
+
+bool
+IngestChannel::isChangesOnly() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_isChangesOnly;
+}
+
+const SourcesFilter &
+IngestChannel::filter() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_filter;
+}
+
+const QString &
+IngestChannel::captureFile() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_captureFile;
+}
+
+bool
+IngestChannel::isConnected() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return d->m_isConnected;
+}
+
+bool
+IngestChannel::isMustBeConnected() const
+{
+	const IngestChannelPrivate * d = d_func();
+
+	return !d->m_isDisconnectedByUser;
+}
+
+void
+IngestChannel::activate()
+{
+}
+
+void
+IngestChannel::deactivate()
+{
+}
+
+void
+IngestChannel::updateTimeoutImplementation( int msecs )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_isAutoTimeout = ( msecs == c_autoTimeout );
+
+	if( d->m_isAutoTimeout )
+	{
+		d->m_adaptiveTimeout.reset();
+
+		msecs = d->m_adaptiveTimeout.timeout();
+	}
+
+	d->m_updateTimeout = msecs;
+
+	emit aboutToUpdateTimeout( msecs );
+
+	if( d->m_isAutoTimeout )
+		emit timeoutChanged( msecs );
+}
+
+void
+IngestChannel::updateAutoTimeoutBoundsImplementation( int minMsecs,
+	int maxMsecs )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_adaptiveTimeout.setBounds( minMsecs, maxMsecs );
+
+	if( d->m_isAutoTimeout )
+		setAutomaticTimeout( d->m_adaptiveTimeout.timeout() );
+}
+
+void
+IngestChannel::setAutomaticTimeout( int msecs )
+{
+	IngestChannelPrivate * d = d_func();
+
+	if( d->m_updateTimeout != msecs )
+	{
+		d->m_updateTimeout = msecs;
+
+		emit aboutToUpdateTimeout( msecs );
+
+		emit timeoutChanged( msecs );
+	}
+}
+
+void
+IngestChannel::updatePendingLimitImplementation( int limit )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_pendingLimit = limit;
+
+	emit aboutToUpdatePendingLimit( limit );
+}
+
+void
+IngestChannel::updateReconnectDelayImplementation( int minMsecs,
+	int maxMsecs )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_reconnectPolicy.setDelays( minMsecs, maxMsecs );
+}
+
+void
+IngestChannel::updateUrgentLevelImplementation( Level level )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_urgentLevel = level;
+
+	emit aboutToUpdateUrgentLevel( level );
+}
+
+void
+IngestChannel::updateChangesOnlyImplementation( bool on )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_isChangesOnly = on;
+
+	emit aboutToUpdateChangesOnly( on );
+}
+
+void
+IngestChannel::updateFilterImplementation( const SourcesFilter & filter )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_filter = filter;
+
+	emit aboutToUpdateFilter( filter.include(), filter.exclude() );
+
+	// Sources that pass new filter should be received again.
+	if( d->m_isConnected )
+		requestSources();
+}
+
+void
+IngestChannel::updateCaptureFileImplementation( const QString & fileName )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_captureFile = fileName;
+
+	emit aboutToUpdateCaptureFile( fileName );
+}
+
+void
+IngestChannel::requestSources()
+{
+}
+
+void
+IngestChannel::sourcesHaveUpdatedValue( const QVector< Como::Source > & sources,
+	qint64 flushedAt )
+{
+	IngestChannelPrivate * d = d_func();
+
+	d->m_latencies.append( static_cast< int > ( steadyMSecs() - flushedAt ) );
+
+	notifySourcesUpdated( sources );
+}
+
+void
+IngestChannel::sourceHasDeregistered( const Como::Source & source )
+{
+	emit sourceDeregistered( source );
+}
+
+void
+IngestChannel::updateStatistics()
+{
+	IngestChannelPrivate * d = d_func();
+
+	ChannelStatistics stat;
+	stat.setMessagesRate( d->m_coalescer->takeMessagesCount() );
+	stat.setDeregistrationsRate( d->m_coalescer->takeDeregistrationsCount() );
+	stat.setCoalescedCount( d->m_coalescer->takeCoalescedCount() );
+	stat.setDroppedCount( d->m_coalescer->takeDroppedCount() );
+	stat.setFilteredCount( d->m_coalescer->takeFilteredCount() );
+	stat.setPendingCount( d->m_coalescer->pendingCount() );
+	stat.setBytesRate( d->m_coalescer->takeBytesCount() );
+	stat.setLatencies( d->m_latencies );
+
+	d->m_latencies.clear();
+
+	notifyStatistics( stat );
+
+	if( d->m_isAutoTimeout )
+		setAutomaticTimeout( d->m_adaptiveTimeout.adjust( stat ) );
+}
+
+} /* namespace Globe */
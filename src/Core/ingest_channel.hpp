@@ -0,0 +1,219 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__INGEST_CHANNEL_HPP__INCLUDED
+#define GLOBE__INGEST_CHANNEL_HPP__INCLUDED
+
+// Globe include.
+#include <Core/channels.hpp>
+#include <Core/reconnect_policy.hpp>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+class QTimer;
+QT_END_NAMESPACE
+
+
+namespace Globe {
+
+class SourcesCoalescer;
+class IngestChannel;
+
+
+//
+// IngestChannelPrivate
+//
+
+class CORE_EXPORT IngestChannelPrivate
+	:	public ChannelPrivate
+{
+public:
+	IngestChannelPrivate( IngestChannel * parent,
+		const QString & name,
+		const QString & address,
+		quint16 port,
+		QThread * thread );
+
+	virtual ~IngestChannelPrivate();
+
+	//! Thread of the producer from the shared I/O thread pool.
+	QThread * m_thread;
+	//! Coalescer of the sources living in the producer's thread.
+	SourcesCoalescer * m_coalescer;
+	//! Timer for updating statistics per second.
+	QTimer * m_rateTimer;
+	//! Latencies between producer's thread and this one in the current second.
+	QVector< int > m_latencies;
+	//! Update of source's value timeout in ms.
+	int m_updateTimeout;
+	//! Is timeout automatic?
+	bool m_isAutoTimeout;
+	//! Automatic timeout.
+	AdaptiveTimeout m_adaptiveTimeout;
+	//! Limit of the pending sources.
+	int m_pendingLimit;
+	//! Level from which updates are delivered without timeout.
+	Level m_urgentLevel;
+	//! Are only changed values delivered?
+	bool m_isChangesOnly;
+	//! Filter of the sources.
+	SourcesFilter m_filter;
+	//! File of the traffic capture.
+	QString m_captureFile;
+	//! Reconnection policy.
+	ReconnectPolicy m_reconnectPolicy;
+	//! Is channel in connected state?
+	bool m_isConnected;
+	//! Is channel was disconnected by user?
+	bool m_isDisconnectedByUser;
+}; // class IngestChannelPrivate
+
+
+//
+// IngestChannel
+//
+
+/*!
+	Base of the channels that receive sources in the thread from
+	the shared I/O thread pool.
+
+	Producer of the sources (socket, generator and so on) lives in
+	that thread and feeds SourcesCoalescer, that sends coalesced
+	sources to this channel. Derived class creates producer, calls
+	initCoalescer() and moves producer to the thread.
+*/
+class CORE_EXPORT IngestChannel
+	:	public Channel
+{
+	Q_OBJECT
+
+signals:
+	//! About to update timeout.
+	void aboutToUpdateTimeout( int );
+	//! About to update limit of the pending sources.
+	void aboutToUpdatePendingLimit( int );
+	//! About to update urgent level.
+	void aboutToUpdateUrgentLevel( int );
+	//! About to update "changes only" mode.
+	void aboutToUpdateChangesOnly( bool );
+	//! About to update filter of the sources.
+	void aboutToUpdateFilter( const QStringList &, const QStringList & );
+	//! About to update file of the traffic capture.
+	void aboutToUpdateCaptureFile( const QString & );
+
+public:
+	~IngestChannel();
+
+	//! \return Timeout in the channel.
+	int timeout() const;
+	//! \return Is timeout adjusted automatically.
+	bool isAutoTimeout() const;
+	//! \return Minimum of the automatic timeout in ms.
+	int minAutoTimeout() const;
+	//! \return Maximum of the automatic timeout in ms.
+	int maxAutoTimeout() const;
+	//! \return Limit of the pending sources in the channel.
+	int pendingLimit() const;
+	//! \return Minimum delay before reconnection in ms.
+	int minReconnectDelay() const;
+	//! \return Maximum delay before reconnection in ms.
+	int maxReconnectDelay() const;
+	//! \return Level from which updates are delivered without timeout.
+	Level urgentLevel() const;
+	//! \return Whether only changed values are delivered.
+	bool isChangesOnly() const;
+	//! \return Filter of the sources.
+	const SourcesFilter & filter() const;
+	//! \return File of the traffic capture, empty if capture is off.
+	const QString & captureFile() const;
+	//! \return Is channel in connected state.
+	bool isConnected() const;
+	//! \return Whether the user wants to make this channel connected.
+	bool isMustBeConnected() const;
+
+protected:
+	IngestChannel(
+		//! Channel private.
+		IngestChannelPrivate * dd );
+
+	/*!
+		Create coalescer as child of the \a producer and connect
+		it with this channel. Must be called before moving of
+		the producer to the thread.
+	*/
+	void initCoalescer( QObject * producer );
+
+	//! Activate channel.
+	void activate();
+	//! Deactivate channel.
+	void deactivate();
+
+	//! Implementation of the "update timeout" operation.
+	void updateTimeoutImplementation( int msecs );
+	//! Implementation of the "update automatic timeout bounds" operation.
+	void updateAutoTimeoutBoundsImplementation( int minMsecs, int maxMsecs );
+	//! Implementation of the "update pending limit" operation.
+	void updatePendingLimitImplementation( int limit );
+	//! Implementation of the "update reconnect delay" operation.
+	void updateReconnectDelayImplementation( int minMsecs, int maxMsecs );
+	//! Implementation of the "update urgent level" operation.
+	void updateUrgentLevelImplementation( Level level );
+	//! Implementation of the "update changes only" operation.
+	void updateChangesOnlyImplementation( bool on );
+	//! Implementation of the "update filter" operation.
+	void updateFilterImplementation( const SourcesFilter & filter );
+	//! Implementation of the "update capture file" operation.
+	void updateCaptureFileImplementation( const QString & fileName );
+
+	/*!
+		Request all sources from the producer again, called when
+		filter changed in connected state. Does nothing by default.
+	*/
+	virtual void requestSources();
+
+protected slots:
+	//! Coalesced sources arrived from the producer's thread.
+	void sourcesHaveUpdatedValue( const QVector< Como::Source > & sources,
+		qint64 flushedAt );
+	//! Como::Source has deregistered.
+	void sourceHasDeregistered( const Como::Source & source );
+
+private slots:
+	//! Update statistics timer shots.
+	void updateStatistics();
+
+private:
+	//! Set timeout chosen in automatic mode.
+	void setAutomaticTimeout( int msecs );
+
+private:
+	Q_DISABLE_COPY( IngestChannel )
+
+	inline IngestChannelPrivate * d_func()
+		{ return static_cast< IngestChannelPrivate* > ( d.data() ); }
+	inline const IngestChannelPrivate * d_func() const
+		{ return static_cast< const IngestChannelPrivate* >( d.data() ); }
+}; // class IngestChannel
+
+} /* namespace Globe */
+
+#endif // GLOBE__INGEST_CHANNEL_HPP__INCLUDED
@@ -0,0 +1,242 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/io_thread_pool.hpp>
+
+// Qt include.
+#include <QThread>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <QtDebug>
+
+
+namespace Globe {
+
+//
+// IOThreadPoolPrivate
+//
+
+class IOThreadPoolPrivate {
+public:
+	IOThreadPoolPrivate()
+		:	m_threadsCount( 0 )
+	{
+	}
+
+	//! \return Maximum count of the threads.
+	int maxThreads() const
+	{
+		return ( m_threadsCount > 0 ? m_threadsCount :
+			qMax( 1, QThread::idealThreadCount() ) );
+	}
+
+	/*!
+		Quit all threads and wait for them until \a deadline.
+		Threads that didn't finish in time are abandoned.
+	*/
+	void stopThreads( const QDeadlineTimer & deadline )
+	{
+		QMutexLocker lock( &m_mutex );
+
+		for( QThread * thread : qAsConst( m_threads ) )
+			thread->quit();
+
+		for( QThread * thread : qAsConst( m_threads ) )
+		{
+			if( thread->wait( deadline ) )
+				delete thread;
+			else
+				qWarning() << "I/O thread" << thread->objectName()
+					<< "didn't finish in time and was abandoned.";
+		}
+
+		m_threads.clear();
+		m_load.clear();
+	}
+
+	//! Configured count of the threads.
+	int m_threadsCount;
+	//! Threads.
+	QVector< QThread* > m_threads;
+	//! Count of the channels in the each thread.
+	QVector< int > m_load;
+	//! Mutex.
+	mutable QMutex m_mutex;
+}; // class IOThreadPoolPrivate
+
+
+//
+// IOThreadPool
+//
+
+IOThreadPool::IOThreadPool()
+	:	d( new IOThreadPoolPrivate )
+{
+}
+
+//! Time to wait for the threads on destruction of the pool in ms.
+static const int c_destructionJoinTimeout = 3000;
+
+IOThreadPool::~IOThreadPool()
+{
+	// There is no event loop here, but threads still have to be joined
+	// if shutdown() wasn't called, i.e. on session end.
+	d->stopThreads( QDeadlineTimer( c_destructionJoinTimeout ) );
+}
+
+static IOThreadPool * ioThreadPoolInstancePointer = 0;
+
+void
+IOThreadPool::cleanup()
+{
+	delete ioThreadPoolInstancePointer;
+
+	ioThreadPoolInstancePointer = 0;
+}
+
+IOThreadPool &
+IOThreadPool::instance()
+{
+	if( !ioThreadPoolInstancePointer )
+	{
+		ioThreadPoolInstancePointer = new IOThreadPool;
+
+		qAddPostRoutine( &IOThreadPool::cleanup );
+	}
+
+	return *ioThreadPoolInstancePointer;
+}
+
+int
+IOThreadPool::threadsCount() const
+{
+	QMutexLocker lock( &d->m_mutex );
+
+	return d->m_threadsCount;
+}
+
+void
+IOThreadPool::setThreadsCount( int count )
+{
+	QMutexLocker lock( &d->m_mutex );
+
+	d->m_threadsCount = qMax( 0, count );
+}
+
+QThread *
+IOThreadPool::acquireThread()
+{
+	QMutexLocker lock( &d->m_mutex );
+
+	const int max = d->maxThreads();
+
+	int index = -1;
+
+	for( int i = 0, last = qMin( max, d->m_threads.size() ); i < last; ++i )
+	{
+		if( index == -1 || d->m_load.at( i ) < d->m_load.at( index ) )
+			index = i;
+	}
+
+	// Start new thread while there are busy ones only.
+	if( ( index == -1 || d->m_load.at( index ) > 0 ) &&
+		d->m_threads.size() < max )
+	{
+		QThread * thread = new QThread;
+		thread->setObjectName( QString( "Globe.IO.%1" )
+			.arg( d->m_threads.size() ) );
+		thread->start();
+
+		d->m_threads.append( thread );
+		d->m_load.append( 0 );
+
+		index = d->m_threads.size() - 1;
+	}
+
+	++d->m_load[ index ];
+
+	return d->m_threads.at( index );
+}
+
+void
+IOThreadPool::releaseThread( QThread * thread )
+{
+	QMutexLocker lock( &d->m_mutex );
+
+	const int index = d->m_threads.indexOf( thread );
+
+	if( index != -1 && d->m_load.at( index ) > 0 )
+		--d->m_load[ index ];
+}
+
+bool
+IOThreadPool::isIdle() const
+{
+	QMutexLocker lock( &d->m_mutex );
+
+	for( const int load : qAsConst( d->m_load ) )
+		if( load > 0 )
+			return false;
+
+	return true;
+}
+
+//! Interval of checking for the released threads on shutdown.
+static const int c_shutdownPollInterval = 10;
+
+void
+IOThreadPool::shutdown( int msecs )
+{
+	const QDeadlineTimer deadline( msecs );
+
+	if( !isIdle() && !deadline.hasExpired() &&
+		QCoreApplication::instance() )
+	{
+		// Channels release threads from the event loop,
+		// so don't block it while waiting.
+		QEventLoop loop;
+		QTimer poll;
+
+		QObject::connect( &poll, &QTimer::timeout,
+			[&]()
+			{
+				if( isIdle() || deadline.hasExpired() )
+					loop.quit();
+			} );
+
+		poll.start( c_shutdownPollInterval );
+
+		// User input is not processed, so windows can't start
+		// shutdown again while waiting.
+		loop.exec( QEventLoop::ExcludeUserInputEvents );
+	}
+
+	d->stopThreads( deadline );
+}
+
+} /* namespace Globe */
@@ -0,0 +1,102 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__IO_THREAD_POOL_HPP__INCLUDED
+#define GLOBE__IO_THREAD_POOL_HPP__INCLUDED
+
+// Qt include.
+#include <QScopedPointer>
+
+// Globe include.
+#include <Core/export.hpp>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+
+namespace Globe {
+
+class IOThreadPoolPrivate;
+
+//
+// IOThreadPool
+//
+
+/*!
+	Shared pool of the I/O threads for the channels.
+
+	Sockets of the channels live in the threads of this pool.
+	Thread with the least count of the channels is given
+	on request. Threads are started on demand up to the
+	configured count.
+*/
+class CORE_EXPORT IOThreadPool {
+private:
+	IOThreadPool();
+
+	~IOThreadPool();
+
+	static void cleanup();
+
+public:
+	//! \return Instance.
+	static IOThreadPool & instance();
+
+	//! \return Maximum count of the threads.
+	int threadsCount() const;
+	/*!
+		Set maximum count of the threads.
+
+		0 means QThread::idealThreadCount(). Already started
+		threads are not stopped if count is decreased, but new
+		channels are placed only to the first \a count threads.
+	*/
+	void setThreadsCount( int count );
+
+	//! \return Thread for the new channel.
+	QThread * acquireThread();
+	//! Release thread that was acquired with acquireThread().
+	void releaseThread( QThread * thread );
+
+	//! \return Whether all acquired threads were released.
+	bool isIdle() const;
+
+	/*!
+		Stop all threads.
+
+		Waits in the event loop up to \a msecs milliseconds
+		for the channels to release their threads, and then
+		up to the rest of this time for the threads to finish.
+		Threads that didn't finish in time are abandoned.
+	*/
+	void shutdown( int msecs = 0 );
+
+private:
+	Q_DISABLE_COPY( IOThreadPool )
+
+	QScopedPointer< IOThreadPoolPrivate > d;
+}; // class IOThreadPool
+
+} /* namespace Globe */
+
+#endif // GLOBE__IO_THREAD_POOL_HPP__INCLUDED
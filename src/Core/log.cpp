@@ -25,6 +25,7 @@
 #include <QString>
 #include <QVariant>
 #include <QSqlQuery>
+#include <QSqlDatabase>
 #include <QMessageBox>
 #include <QVector>
 #include <QTimer>
@@ -350,6 +351,44 @@ Log::writeMsgToSourcesLog( const QDateTime & dateTime,
 	}
 }
 
+void
+Log::writeMsgsToSourcesLog( const QString & channelName,
+	const QVector< Como::Source > & sources )
+{
+	if( d->m_cfg.isSourcesLogEnabled() && !sources.isEmpty() )
+	{
+		if( d->m_logState == ReadyLogState &&
+			d->m_dbState == AllIsOkDBState )
+		{
+			QSqlDatabase db = DB::instance().connection();
+
+			db.transaction();
+
+			QSqlQuery insert;
+
+			insert.prepare( QLatin1String(
+				"INSERT INTO sourcesLog ( dateTime, channelName, type, "
+				"sourceName, typeName, value, desc ) "
+				"VALUES ( ?, ?, ?, ?, ?, ?, ? )" ) );
+
+			for( const auto & source : sources )
+			{
+				insert.addBindValue( dateTimeToString( source.dateTime() ) );
+				insert.addBindValue( channelName );
+				insert.addBindValue( (int) source.type() );
+				insert.addBindValue( source.name() );
+				insert.addBindValue( source.typeName() );
+				insert.addBindValue( source.value().toString() );
+				insert.addBindValue( source.description() );
+
+				insert.exec();
+			}
+
+			db.commit();
+		}
+	}
+}
+
 QSqlQuery
 Log::readAllEventLog()
 {
@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QScopedPointer>
 #include <QSqlQuery>
+#include <QVector>
 
 // Como include.
 #include <Como/Source>
@@ -92,6 +93,9 @@ public:
 		const QString & typeName,
 		const QVariant & value,
 		const QString & desc );
+	//! Write messages with the given sources to the source's log.
+	void writeMsgsToSourcesLog( const QString & channelName,
+		const QVector< Como::Source > & sources );
 
 	//! Read all records from the event's log.
 	QSqlQuery readAllEventLog();
@@ -151,15 +151,13 @@ LogSourcesSelector::channelNameChanged( const QString & text )
 
 	if( SourcesManager::instance().channelsNames().contains( text ) )
 	{
-		const QList< Como::Source > sources =
-			SourcesManager::instance().sources( text );
-
-		foreach( const Como::Source & s, sources )
-		{
-			d->m_typesNames[ s.typeName() ].append( s.name() );
+		SourcesManager::instance().forEachSource( text,
+			[this] ( SourceId, const Como::Source & s, bool )
+			{
+				d->m_typesNames[ s.typeName() ].append( s.name() );
 
-			d->m_ui.m_type->addItem( s.typeName() );
-		}
+				d->m_ui.m_type->addItem( s.typeName() );
+			} );
 	}
 }
 
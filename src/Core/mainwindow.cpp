@@ -39,6 +39,7 @@
 #include <Core/sounds.hpp>
 #include <Core/utils.hpp>
 #include <Core/channels.hpp>
+#include <Core/sources_snapshot.hpp>
 
 #include <Scheme/window.hpp>
 
@@ -385,6 +386,8 @@ void
 MainWindow::sessionFinished( QSessionManager & )
 {
 	saveConfiguration();
+
+	SourcesSnapshot::instance().write();
 }
 
 void
@@ -527,6 +530,11 @@ MainWindow::settings()
 void
 MainWindow::shutdown()
 {
+	if( d->m_isQuit )
+		return;
+
+	d->m_isQuit = true;
+
 	const QMessageBox::StandardButton btn = QMessageBox::question( this,
 		tr( "Saving configuration..." ),
 		tr( "Would you like to save configuration?" ),
@@ -536,6 +544,9 @@ MainWindow::shutdown()
 	if( btn == QMessageBox::Save )
 		saveConfiguration();
 
+	// Before channels are disconnected and sources are deregistered.
+	SourcesSnapshot::instance().write();
+
 	foreach( ChannelViewWindow * w, d->m_channelViewWindows )
 		w->close();
 
@@ -544,8 +555,6 @@ MainWindow::shutdown()
 
 	ChannelsManager::instance().shutdown();
 
-	d->m_isQuit = true;
-
 	QApplication::quit();
 }
 
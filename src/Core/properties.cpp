@@ -32,11 +32,13 @@ namespace Globe {
 
 Properties::Properties()
 	:	m_priority( 0 )
+	,	m_updateTimeout( c_channelUpdateTimeout )
 {
 }
 
 Properties::Properties( const Properties & other )
 	:	m_priority( other.priority() )
+	,	m_updateTimeout( other.updateTimeout() )
 	,	m_conditions( other.m_conditions )
 	,	m_otherwise( other.m_otherwise )
 {
@@ -48,6 +50,7 @@ Properties::operator = ( const Properties & other )
 	if( this != &other )
 	{
 		m_priority = other.priority();
+		m_updateTimeout = other.updateTimeout();
 		m_conditions = other.m_conditions;
 		m_otherwise = other.m_otherwise;
 	}
@@ -67,6 +70,18 @@ Properties::setPriority( int p )
 	m_priority = p;
 }
 
+int
+Properties::updateTimeout() const
+{
+	return m_updateTimeout;
+}
+
+void
+Properties::setUpdateTimeout( int msecs )
+{
+	m_updateTimeout = msecs;
+}
+
 int
 Properties::conditionsAmount() const
 {
@@ -41,6 +41,10 @@
 
 namespace Globe {
 
+//! Update timeout of the source is the channel's one.
+static const int c_channelUpdateTimeout = -1;
+
+
 //
 // Properties
 //
@@ -59,6 +63,14 @@ public:
 	//! Set priority of the source.
 	void setPriority( int p );
 
+	/*!
+		\return Update timeout of the source in ms, or
+		c_channelUpdateTimeout if channel's timeout is used.
+	*/
+	int updateTimeout() const;
+	//! Set update timeout of the source in ms.
+	void setUpdateTimeout( int msecs );
+
 	//! \return Amount of conditions.
 	int conditionsAmount() const;
 	//! \return Condition with the given index.
@@ -82,6 +94,8 @@ public:
 private:
 	//! Priority of the source.
 	int m_priority;
+	//! Update timeout of the source.
+	int m_updateTimeout;
 	//! List of conditions for this source.
 	QList< Condition > m_conditions;
 	//! Otherwise condition.
@@ -103,27 +117,36 @@ public:
 		:	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > (
 				QLatin1String( "properties" ), true )
 		,	m_priority( *this, QLatin1String( "priority" ), false )
+		,	m_updateTimeout( *this, QLatin1String( "updateTimeout" ), false )
 		,	m_conditions( *this, QLatin1String( "if" ), false )
 		,	m_otherwise( *this, QLatin1String( "otherwise" ), false )
 		,	m_priorityConstraint( 0, 999 )
+		,	m_updateTimeoutConstraint( 0, 10000 )
 	{
 		m_priority.set_constraint( &m_priorityConstraint );
+		m_updateTimeout.set_constraint( &m_updateTimeoutConstraint );
 	}
 
 	PropertiesTag( const Properties & properties )
 		:	cfgfile::tag_no_value_t< cfgfile::qstring_trait_t > (
 				QLatin1String( "properties" ), true )
 		,	m_priority( *this, QLatin1String( "priority" ), false )
+		,	m_updateTimeout( *this, QLatin1String( "updateTimeout" ), false )
 		,	m_conditions( *this, QLatin1String( "if" ), false )
 		,	m_otherwise( properties.otherwise(), *this,
 				QLatin1String( "otherwise" ), false )
 		,	m_priorityConstraint( 0, 999 )
+		,	m_updateTimeoutConstraint( 0, 10000 )
 	{
 		m_priority.set_constraint( &m_priorityConstraint );
+		m_updateTimeout.set_constraint( &m_updateTimeoutConstraint );
 
 		if( properties.priority() > 0 )
 			m_priority.set_value( properties.priority() );
 
+		if( properties.updateTimeout() != c_channelUpdateTimeout )
+			m_updateTimeout.set_value( properties.updateTimeout() );
+
 		for( int i = 0; i < properties.conditionsAmount(); ++i )
 		{
 			typename cfgfile::tag_vector_of_tags_t< ConditionTag< T >,
@@ -144,6 +167,9 @@ public:
 		if( m_priority.is_defined() )
 			p.setPriority( m_priority.value() );
 
+		if( m_updateTimeout.is_defined() )
+			p.setUpdateTimeout( m_updateTimeout.value() );
+
 		if( m_conditions.is_defined() )
 		{
 			for( std::size_t i = 0; i < m_conditions.size(); ++i )
@@ -160,6 +186,8 @@ public:
 private:
 	//! Priority.
 	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_priority;
+	//! Update timeout.
+	cfgfile::tag_scalar_t< int, cfgfile::qstring_trait_t > m_updateTimeout;
 	//! Conditions.
 	cfgfile::tag_vector_of_tags_t< ConditionTag< T >,
 		cfgfile::qstring_trait_t > m_conditions;
@@ -167,6 +195,8 @@ private:
 	OtherwiseTag m_otherwise;
 	//! Constraint for the priority.
 	cfgfile::constraint_min_max_t< int > m_priorityConstraint;
+	//! Constraint for the update timeout.
+	cfgfile::constraint_min_max_t< int > m_updateTimeoutConstraint;
 }; // class PropertiesTag
 
 
@@ -47,6 +47,10 @@
 #include <QCloseEvent>
 #include <QMenuBar>
 #include <QCoreApplication>
+#include <QReadWriteLock>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QHash>
 
 
 namespace Globe {
@@ -120,6 +124,22 @@ public:
 		}
 	}
 
+	//! \return Map of properties for the given key's type.
+	const PropertiesMap & map( PropertiesKeyType type ) const
+	{
+		switch( type )
+		{
+			case ExactlyThisSource :
+				return m_exactlyThisSourceMap;
+			case ExactlyThisSourceInAnyChannel :
+				return m_exactlyThisSourceInAnyChannelMap;
+			case ExactlyThisTypeOfSource :
+				return m_exactlyThisTypeOfSourceMap;
+			default :
+				return m_exactlyThisTypeOfSourceInAnyChannelMap;
+		}
+	}
+
 	//! Save new properties.
 	void saveNewProperties( const PropertiesKey & key, const Properties & p,
 		const Como::Source & source,
@@ -138,14 +158,20 @@ public:
 		{
 			PropertiesValue value( fileName, source.type(), p );
 
-			if( type == ExactlyThisSource )
-				m_exactlyThisSourceMap.insert( key, value );
-			else if( type == ExactlyThisSourceInAnyChannel )
-				m_exactlyThisSourceInAnyChannelMap.insert( key, value );
-			else if( type == ExactlyThisTypeOfSource )
-				m_exactlyThisTypeOfSourceMap.insert( key, value );
-			else
-				m_exactlyThisTypeOfSourceInAnyChannelMap.insert( key, value );
+			{
+				QWriteLocker lock( &m_lock );
+
+				m_keyTypes.clear();
+
+				if( type == ExactlyThisSource )
+					m_exactlyThisSourceMap.insert( key, value );
+				else if( type == ExactlyThisSourceInAnyChannel )
+					m_exactlyThisSourceInAnyChannelMap.insert( key, value );
+				else if( type == ExactlyThisTypeOfSource )
+					m_exactlyThisTypeOfSourceMap.insert( key, value );
+				else
+					m_exactlyThisTypeOfSourceInAnyChannelMap.insert( key, value );
+			}
 
 			m_model->addPropertie( key, value );
 
@@ -188,7 +214,11 @@ public:
 		const QString & sourceAsString, const QString & keyAsString,
 		const QString & channelName )
 	{
-		it.value().properties() = p;
+		{
+			QWriteLocker lock( &m_lock );
+
+			it.value().properties() = p;
+		}
 
 		const QString propertieConfFileName =
 			Configuration::instance().path() + m_directoryName + it.value().confFileName();
@@ -248,6 +278,16 @@ public:
 	ToolWindowObject * m_toolWindowObject;
 	//! Parent.
 	PropertiesManager * m_parent;
+	/*!
+		Types of the matched keys by identifiers of the sources,
+		NotDefinedKeyType if source doesn't have properties.
+	*/
+	mutable QHash< SourceId, PropertiesKeyType > m_keyTypes;
+	/*!
+		Lock for the maps of properties. Maps are changed only in
+		the GUI thread, so reading in the GUI thread doesn't need it.
+	*/
+	mutable QReadWriteLock m_lock;
 }; // class PropertiesManagerPrivate
 
 
@@ -424,6 +464,34 @@ PropertiesManager::findProperties( const Como::Source & source,
 	return 0;
 }
 
+Level
+PropertiesManager::evaluateLevel( const Como::Source & source,
+	const QString & channelName ) const
+{
+	QReadLocker lock( &d->m_lock );
+
+	const Properties * props = findProperties( source, channelName, 0 );
+
+	if( props )
+		return props->checkConditions( source.value(), source.type() ).level();
+	else
+		return None;
+}
+
+int
+PropertiesManager::updateTimeout( const Como::Source & source,
+	const QString & channelName ) const
+{
+	QReadLocker lock( &d->m_lock );
+
+	const Properties * props = findProperties( source, channelName, 0 );
+
+	if( props )
+		return props->updateTimeout();
+	else
+		return c_channelUpdateTimeout;
+}
+
 static inline PropertiesKey createKey( PropertiesKeyType type,
 	const Como::Source & source, const QString & channelName )
 {
@@ -442,6 +510,44 @@ static inline PropertiesKey createKey( PropertiesKeyType type,
 	}
 }
 
+const Properties *
+PropertiesManager::findProperties( SourceId id, const Como::Source & source,
+	const QString & channelName ) const
+{
+	const auto it = d->m_keyTypes.constFind( id );
+
+	if( it == d->m_keyTypes.cend() )
+	{
+		PropertiesKey key;
+
+		const Properties * props = findProperties( source, channelName, &key );
+
+		d->m_keyTypes.insert( id, ( props ? key.keyType() : NotDefinedKeyType ) );
+
+		return props;
+	}
+	else if( it.value() == NotDefinedKeyType )
+		return 0;
+	else
+	{
+		const PropertiesMap & map = d->map( it.value() );
+
+		PropertiesMap::ConstIterator pit = map.find(
+			createKey( it.value(), source, channelName ) );
+
+		if( pit != map.cend() )
+			return &pit.value().properties();
+		else
+			return 0;
+	}
+}
+
+void
+PropertiesManager::forgetSource( SourceId id )
+{
+	d->m_keyTypes.remove( id );
+}
+
 static inline QString sourceToString( const Como::Source & source )
 {
 	QString result;
@@ -556,14 +662,20 @@ PropertiesManager::removeProperties( const PropertiesKey & key,
 			}
 		}
 
-		if( key.keyType() == ExactlyThisSource )
-			d->m_exactlyThisSourceMap.remove( key );
-		else if( key.keyType() == ExactlyThisSourceInAnyChannel )
-			d->m_exactlyThisSourceInAnyChannelMap.remove( key );
-		else if( key.keyType() == ExactlyThisTypeOfSource )
-			d->m_exactlyThisTypeOfSourceMap.remove( key );
-		else
-			d->m_exactlyThisTypeOfSourceInAnyChannelMap.remove( key );
+		{
+			QWriteLocker lock( &d->m_lock );
+
+			d->m_keyTypes.clear();
+
+			if( key.keyType() == ExactlyThisSource )
+				d->m_exactlyThisSourceMap.remove( key );
+			else if( key.keyType() == ExactlyThisSourceInAnyChannel )
+				d->m_exactlyThisSourceInAnyChannelMap.remove( key );
+			else if( key.keyType() == ExactlyThisTypeOfSource )
+				d->m_exactlyThisTypeOfSourceMap.remove( key );
+			else
+				d->m_exactlyThisTypeOfSourceInAnyChannelMap.remove( key );
+		}
 
 		Log::instance().writeMsgToEventLog( LogLevelInfo,
 			QString( "Properties for key %1 was deleted." )
@@ -607,8 +719,12 @@ PropertiesManager::editProperties( const PropertiesKey & key, QWidget * parent )
 					"was edited." )
 					.arg( keyAsString ) );
 
-			it.value().properties() =
-				propertiesDialog.propertiesWidget()->properties();
+			{
+				QWriteLocker lock( &d->m_lock );
+
+				it.value().properties() =
+					propertiesDialog.propertiesWidget()->properties();
+			}
 
 			emit propertiesChanged();
 
@@ -811,9 +927,17 @@ PropertiesManager::readPropertiesConfigs( PropertiesMap & map )
 		const QString keyAsString = keyToString( it.key() );
 
 		try {
+			Properties props;
+
 			readPropertiesConfiguration(
 				Configuration::instance().path() + d->m_directoryName + it.value().confFileName(),
-				it.value().properties(), it.value().valueType() );
+				props, it.value().valueType() );
+
+			{
+				QWriteLocker lock( &d->m_lock );
+
+				it.value().properties() = props;
+			}
 
 			Log::instance().writeMsgToEventLog( LogLevelInfo,
 				QString( "Propertie's configuration for key %1\n"
@@ -855,6 +979,10 @@ PropertiesManager::readPropertiesConfigs( PropertiesMap & map )
 		}
 	}
 
+	QWriteLocker lock( &d->m_lock );
+
+	d->m_keyTypes.clear();
+
 	foreach( const PropertiesKey & key, toRemove )
 		map.remove( key );
 }
@@ -922,13 +1050,19 @@ PropertiesManager::readConfiguration( const QString & fileName )
 
 		checkDirAndCreateIfNotExists( Configuration::instance().path(), d->m_directoryName );
 
-		d->m_exactlyThisSourceMap = tag.exactlyThisSourceMap();
-		d->m_exactlyThisSourceInAnyChannelMap =
-			tag.exactlyThisSourceInAnyChannelMap();
-		d->m_exactlyThisTypeOfSourceMap =
-			tag.exactlyThisTypeOfSourceMap();
-		d->m_exactlyThisTypeOfSourceInAnyChannelMap =
-			tag.exactlyThisTypeOfSourceInAnyChannelMap();
+		{
+			QWriteLocker lock( &d->m_lock );
+
+			d->m_keyTypes.clear();
+
+			d->m_exactlyThisSourceMap = tag.exactlyThisSourceMap();
+			d->m_exactlyThisSourceInAnyChannelMap =
+				tag.exactlyThisSourceInAnyChannelMap();
+			d->m_exactlyThisTypeOfSourceMap =
+				tag.exactlyThisTypeOfSourceMap();
+			d->m_exactlyThisTypeOfSourceInAnyChannelMap =
+				tag.exactlyThisTypeOfSourceInAnyChannelMap();
+		}
 
 		restoreWindowState( tag.windowState(), this );
 	}
@@ -30,6 +30,7 @@
 // Globe include.
 #include <Core/tool_window.hpp>
 #include <Core/properties_map.hpp>
+#include <Core/source_id.hpp>
 #include <Core/export.hpp>
 
 QT_BEGIN_NAMESPACE
@@ -73,6 +74,32 @@ public:
 	*/
 	const Properties * findProperties( const Como::Source & source,
 		const QString & channelName, PropertiesKey * resultedkey ) const;
+	/*!
+		\return Properties for the source with the given identifier.
+		\retval NULL if there is no properties for the given source.
+
+		Type of the matched key is cached by the identifier of the source
+		until properties are added or removed, so only one lookup is
+		needed for the source.
+	*/
+	const Properties * findProperties( SourceId id, const Como::Source & source,
+		const QString & channelName ) const;
+	//! Forget cached type of the key of the released identifier.
+	void forgetSource( SourceId id );
+	/*!
+		\return Level of the given source evaluated with it's properties.
+		\retval None if there is no properties for the given source.
+
+		\note Unlike findProperties() this method is thread-safe.
+	*/
+	Level evaluateLevel( const Como::Source & source,
+		const QString & channelName ) const;
+	/*!
+		\return Update timeout of the source in ms or
+		c_channelUpdateTimeout. Thread-safe.
+	*/
+	int updateTimeout( const Como::Source & source,
+		const QString & channelName ) const;
 	//! Add new properties.
 	void addProperties( const Como::Source & source,
 		const QString & channelName, QWidget * parent = 0 );
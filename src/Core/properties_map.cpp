@@ -23,6 +23,9 @@
 // Globe include.
 #include <Core/properties_map.hpp>
 
+// C++ include.
+#include <tuple>
+
 
 namespace Globe {
 
@@ -103,14 +106,14 @@ bool operator < ( const PropertiesKey & k1, const PropertiesKey & k2 )
 	switch( k1.keyType() )
 	{
 		case ExactlyThisSource :
-			return ( ( k1.name() + k1.typeName() + k1.channelName() ) <
-				( k2.name() + k2.typeName() + k2.channelName() ) );
+			return ( std::tie( k1.name(), k1.typeName(), k1.channelName() ) <
+				std::tie( k2.name(), k2.typeName(), k2.channelName() ) );
 		case ExactlyThisSourceInAnyChannel :
-			return ( ( k1.name() + k1.typeName() ) <
-			( k2.name() + k2.typeName() ) );
+			return ( std::tie( k1.name(), k1.typeName() ) <
+				std::tie( k2.name(), k2.typeName() ) );
 		case ExactlyThisTypeOfSource :
-			return ( ( k1.typeName() + k1.channelName() ) <
-			( k2.typeName() + k2.channelName() ) );
+			return ( std::tie( k1.typeName(), k1.channelName() ) <
+				std::tie( k2.typeName(), k2.channelName() ) );
 		case ExactlyThisTypeOfSourceInAnyChannel :
 			return ( k1.typeName() < k2.typeName() );
 
@@ -106,6 +106,38 @@ private:
 }; // class ComboBoxDelegate
 
 
+//
+// UpdateTimeoutSpinBox
+//
+
+/*!
+	Spin box of the update timeout. First step up from the special
+	value of the channel's timeout goes to 0, not to 99.
+*/
+class UpdateTimeoutSpinBox
+	:	public QSpinBox
+{
+public:
+	explicit UpdateTimeoutSpinBox( QWidget * parent = 0 )
+		:	QSpinBox( parent )
+	{
+	}
+
+	void stepBy( int steps ) override
+	{
+		if( value() == c_channelUpdateTimeout && steps > 0 )
+		{
+			setValue( 0 );
+
+			--steps;
+		}
+
+		if( steps != 0 )
+			QSpinBox::stepBy( steps );
+	}
+}; // class UpdateTimeoutSpinBox
+
+
 //
 // PropertiesListPrivate
 //
@@ -440,6 +472,7 @@ public:
 		:	m_valueType( valueType )
 		,	m_conditions( 0 )
 		,	m_priority( 0 )
+		,	m_updateTimeout( 0 )
 	{
 	}
 
@@ -449,6 +482,8 @@ public:
 	PropertiesList * m_conditions;
 	//! Priority.
 	QSpinBox * m_priority;
+	//! Update timeout.
+	QSpinBox * m_updateTimeout;
 }; // class PropertiesWidgetPrivate
 
 
@@ -474,6 +509,7 @@ PropertiesWidget::properties() const
 	Properties props = d->m_conditions->properties();
 
 	props.setPriority( d->m_priority->value() );
+	props.setUpdateTimeout( d->m_updateTimeout->value() );
 
 	return props;
 }
@@ -482,6 +518,7 @@ void
 PropertiesWidget::setProperties( const Properties & p )
 {
 	d->m_priority->setValue( p.priority() );
+	d->m_updateTimeout->setValue( p.updateTimeout() );
 
 	d->m_conditions->setProperties( p );
 }
@@ -513,6 +550,15 @@ PropertiesWidget::priorityChanged( int p )
 		emit changed();
 }
 
+void
+PropertiesWidget::updateTimeoutChanged( int msecs )
+{
+	Q_UNUSED( msecs )
+
+	if( d->m_conditions->isPropertiesOk() )
+		emit changed();
+}
+
 void
 PropertiesWidget::init()
 {
@@ -533,6 +579,21 @@ PropertiesWidget::init()
 
 	hBox->addWidget( d->m_priority );
 
+	QLabel * timeoutLabel = new QLabel( this );
+	timeoutLabel->setText( tr( "Update Timeout" ) );
+	hBox->addWidget( timeoutLabel );
+
+	d->m_updateTimeout = new UpdateTimeoutSpinBox( this );
+	d->m_updateTimeout->setMinimum( c_channelUpdateTimeout );
+	d->m_updateTimeout->setMaximum( 10000 );
+	d->m_updateTimeout->setSingleStep( 100 );
+	d->m_updateTimeout->setSuffix( tr( " ms" ) );
+	d->m_updateTimeout->setSpecialValueText( tr( "Channel's" ) );
+	d->m_updateTimeout->setToolTip(
+		tr( "Timeout of the value updates of this source in the channel" ) );
+
+	hBox->addWidget( d->m_updateTimeout );
+
 	QSpacerItem * spacer = new QSpacerItem( 20, 20, QSizePolicy::Expanding,
 		QSizePolicy::Minimum );
 
@@ -554,6 +615,9 @@ PropertiesWidget::init()
 
 	connect( d->m_priority, signal,
 		this, &PropertiesWidget::priorityChanged );
+
+	connect( d->m_updateTimeout, signal,
+		this, &PropertiesWidget::updateTimeoutChanged );
 }
 
 } /* namespace Globe */
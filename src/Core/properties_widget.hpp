@@ -75,6 +75,8 @@ private slots:
 	void propertiesWrong();
 	//! Priority changed.
 	void priorityChanged( int p );
+	//! Update timeout changed.
+	void updateTimeoutChanged( int msecs );
 
 private:
 	//! Init.
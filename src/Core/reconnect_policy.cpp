@@ -0,0 +1,94 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/reconnect_policy.hpp>
+
+// Qt include.
+#include <QRandomGenerator>
+#include <QtGlobal>
+
+
+namespace Globe {
+
+//
+// ReconnectPolicy
+//
+
+ReconnectPolicy::ReconnectPolicy( int minDelay, int maxDelay )
+	:	m_minDelay( 0 )
+	,	m_maxDelay( 0 )
+	,	m_attempt( 0 )
+{
+	setDelays( minDelay, maxDelay );
+}
+
+int
+ReconnectPolicy::minDelay() const
+{
+	return m_minDelay;
+}
+
+int
+ReconnectPolicy::maxDelay() const
+{
+	return m_maxDelay;
+}
+
+void
+ReconnectPolicy::setDelays( int minDelay, int maxDelay )
+{
+	m_minDelay = qMax( 1, minDelay );
+	m_maxDelay = qMax( m_minDelay, maxDelay );
+}
+
+int
+ReconnectPolicy::attempt() const
+{
+	return m_attempt;
+}
+
+int
+ReconnectPolicy::nextDelay()
+{
+	qint64 delay = m_minDelay;
+
+	for( int i = 0; i < m_attempt && delay < m_maxDelay; ++i )
+		delay *= 2;
+
+	delay = qMin( delay, static_cast< qint64 > ( m_maxDelay ) );
+
+	++m_attempt;
+
+	const qint64 half = delay / 2;
+
+	return static_cast< int > ( delay - half +
+		QRandomGenerator::global()->bounded( half + 1 ) );
+}
+
+void
+ReconnectPolicy::reset()
+{
+	m_attempt = 0;
+}
+
+} /* namespace Globe */
@@ -0,0 +1,82 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__RECONNECT_POLICY_HPP__INCLUDED
+#define GLOBE__RECONNECT_POLICY_HPP__INCLUDED
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//! Default minimum delay before reconnection in ms.
+static const int c_defaultMinReconnectDelay = 1000;
+//! Default maximum delay before reconnection in ms.
+static const int c_defaultMaxReconnectDelay = 60000;
+
+
+//
+// ReconnectPolicy
+//
+
+/*!
+	Policy of the reconnection of the channel.
+
+	Delay before the next attempt grows exponentially from
+	minimum to maximum delay. The delay is randomized in
+	the upper half of it, so channels disconnected at the same
+	time will not reconnect at the same time.
+*/
+class CORE_EXPORT ReconnectPolicy {
+public:
+	ReconnectPolicy( int minDelay = c_defaultMinReconnectDelay,
+		int maxDelay = c_defaultMaxReconnectDelay );
+
+	//! \return Minimum delay in ms.
+	int minDelay() const;
+	//! \return Maximum delay in ms.
+	int maxDelay() const;
+	//! Set minimum and maximum delays in ms.
+	void setDelays( int minDelay, int maxDelay );
+
+	//! \return Count of attempts since last reset.
+	int attempt() const;
+
+	//! \return Delay before the next attempt in ms and count this attempt.
+	int nextDelay();
+
+	//! Reset count of attempts, i.e. after successful connection.
+	void reset();
+
+private:
+	//! Minimum delay.
+	int m_minDelay;
+	//! Maximum delay.
+	int m_maxDelay;
+	//! Count of attempts.
+	int m_attempt;
+}; // class ReconnectPolicy
+
+} /* namespace Globe */
+
+#endif // GLOBE__RECONNECT_POLICY_HPP__INCLUDED
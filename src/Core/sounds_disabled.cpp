@@ -25,12 +25,14 @@
 #include <Core/sounds_disabled_data.hpp>
 #include <Core/sounds_disabled_cfg.hpp>
 #include <Core/log.hpp>
+#include <Core/source_id.hpp>
 
 // Qt include.
 #include <QTimer>
 #include <QMessageBox>
 #include <QCoreApplication>
 #include <QFile>
+#include <QSet>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -49,10 +51,50 @@ public:
 	{
 	}
 
+	//! Rebuild set of identifiers of the sources with disabled sounds.
+	void rebuildDisabled()
+	{
+		for( const SourceId id : qAsConst( m_disabled ) )
+			SourceIds::instance().unpin( id );
+
+		m_disabled.clear();
+
+		for( DisabledSoundsMap::ConstIterator it = m_map.cbegin(),
+			last = m_map.cend(); it != last; ++it )
+		{
+			for( const DisabledSoundsData & data : it.value() )
+				insert( data.source(), it.key() );
+		}
+	}
+
+	//! Insert identifier of the source, identifier is pinned.
+	void insert( const Como::Source & source, const QString & channelName )
+	{
+		const SourceId id = SourceIds::instance().id( channelName, source );
+
+		if( !m_disabled.contains( id ) )
+		{
+			m_disabled.insert( id );
+
+			SourceIds::instance().pin( id );
+		}
+	}
+
+	//! Remove identifier of the source.
+	void remove( const Como::Source & source, const QString & channelName )
+	{
+		const SourceId id = SourceIds::instance().find( channelName, source );
+
+		if( m_disabled.remove( id ) )
+			SourceIds::instance().unpin( id );
+	}
+
 	//! Timer.
 	QTimer * m_timer;
 	//! Map of disabled sounds.
 	DisabledSoundsMap m_map;
+	//! Identifiers of the sources with disabled sounds.
+	QSet< SourceId > m_disabled;
 }; // class DisabledSoundsPrivate
 
 
@@ -98,13 +140,8 @@ bool
 DisabledSounds::isSoundsEnabled( const Como::Source & source,
 	const QString & channelName )
 {
-	const int index = d->m_map[ channelName ].indexOf(
-		DisabledSoundsData( source ) );
-
-	if( index == -1 )
-		return true;
-	else
-		return false;
+	return !d->m_disabled.contains(
+		SourceIds::instance().find( channelName, source ) );
 }
 
 void
@@ -119,6 +156,8 @@ DisabledSounds::disableSounds( const Como::Source & source,
 	{
 		d->m_map[ channelName ].append( DisabledSoundsData( source, to ) );
 
+		d->insert( source, channelName );
+
 		emit soundsDisabled( source, channelName, to );
 	}
 	else
@@ -136,6 +175,8 @@ DisabledSounds::enableSounds( const Como::Source & source,
 	{
 		d->m_map[ channelName ].removeAt( index );
 
+		d->remove( source, channelName );
+
 		emit soundsEnabled( source, channelName );
 	}
 }
@@ -192,6 +233,8 @@ DisabledSounds::readCfg( const QString & fileName )
 
 	d->m_map = tag.cfg().map();
 
+	d->rebuildDisabled();
+
 	checkAndEnableIf();
 
 	notifyAboutDisabledSounds();
@@ -270,6 +313,8 @@ DisabledSounds::checkAndEnableIf()
 		{
 			it.value().removeOne( data );
 
+			d->remove( data.source(), it.key() );
+
 			emit soundsEnabled( data.source(), it.key() );
 		}
 	}
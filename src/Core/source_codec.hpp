@@ -0,0 +1,253 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__SOURCE_CODEC_HPP__INCLUDED
+#define GLOBE__SOURCE_CODEC_HPP__INCLUDED
+
+// Qt include.
+#include <QByteArray>
+#include <QDateTime>
+#include <QTime>
+#include <QtEndian>
+
+// Como include.
+#include <Como/Source>
+
+
+namespace Globe {
+
+/*
+	Compact binary encoding of the sources shared by the capture
+	and the snapshot files. All numbers are little-endian, strings
+	are UTF-8 prefixed with the size.
+*/
+
+//! Stored invalid date and time.
+static const qint64 c_invalidDateTime = Q_INT64_C( -0x7FFFFFFFFFFFFFFF );
+
+
+//
+// Encoding
+//
+
+template< typename T >
+static inline void put( QByteArray & buf, T value )
+{
+	uchar data[ sizeof( T ) ];
+
+	qToLittleEndian( value, data );
+
+	buf.append( reinterpret_cast< const char* > ( data ), sizeof( T ) );
+}
+
+static inline void putString( QByteArray & buf, const QString & str )
+{
+	const QByteArray utf8 = str.toUtf8();
+
+	put< quint32 > ( buf, static_cast< quint32 > ( utf8.size() ) );
+
+	buf.append( utf8 );
+}
+
+static inline qint64 dateTimeToNumber( const QDateTime & dt )
+{
+	return ( dt.isValid() ? dt.toMSecsSinceEpoch() : c_invalidDateTime );
+}
+
+static inline QDateTime numberToDateTime( qint64 msecs )
+{
+	return ( msecs == c_invalidDateTime ? QDateTime() :
+		QDateTime::fromMSecsSinceEpoch( msecs ) );
+}
+
+static inline void putValue( QByteArray & buf, const Como::Source & source )
+{
+	const QVariant & value = source.value();
+
+	switch( source.type() )
+	{
+		case Como::Source::Int :
+			put< qint32 > ( buf, value.toInt() );
+			break;
+		case Como::Source::UInt :
+			put< quint32 > ( buf, value.toUInt() );
+			break;
+		case Como::Source::LongLong :
+			put< qint64 > ( buf, value.toLongLong() );
+			break;
+		case Como::Source::ULongLong :
+			put< quint64 > ( buf, value.toULongLong() );
+			break;
+		case Como::Source::Double :
+			put< double > ( buf, value.toDouble() );
+			break;
+		case Como::Source::DateTime :
+			put< qint64 > ( buf, dateTimeToNumber( value.toDateTime() ) );
+			break;
+		case Como::Source::Time :
+		{
+			const QTime t = value.toTime();
+
+			put< qint32 > ( buf, t.isValid() ? t.msecsSinceStartOfDay() : -1 );
+		}
+			break;
+		default :
+			putString( buf, value.toString() );
+			break;
+	}
+}
+
+//! Put type, date and time, name, type name, description and value.
+static inline void putSource( QByteArray & buf, const Como::Source & source )
+{
+	put< quint8 > ( buf, static_cast< quint8 > ( source.type() ) );
+	put< qint64 > ( buf, dateTimeToNumber( source.dateTime() ) );
+	putString( buf, source.name() );
+	putString( buf, source.typeName() );
+	putString( buf, source.description() );
+	putValue( buf, source );
+}
+
+
+//
+// SourceCursor
+//
+
+//! Cursor in the encoded data.
+class SourceCursor {
+public:
+	SourceCursor( const uchar * data, qint64 size )
+		:	m_data( data )
+		,	m_left( size )
+		,	m_isOk( true )
+	{
+	}
+
+	//! \return Were all reads inside of the data?
+	bool isOk() const
+	{
+		return m_isOk;
+	}
+
+	//! \return Is there no more data?
+	bool atEnd() const
+	{
+		return ( m_left == 0 );
+	}
+
+	template< typename T >
+	T get()
+	{
+		if( !take( sizeof( T ) ) )
+			return T();
+
+		return qFromLittleEndian< T > ( m_data - sizeof( T ) );
+	}
+
+	QString getString()
+	{
+		const quint32 size = get< quint32 > ();
+
+		if( !take( size ) )
+			return QString();
+
+		return QString::fromUtf8( reinterpret_cast< const char* > (
+			m_data - size ), static_cast< int > ( size ) );
+	}
+
+	QVariant getValue( Como::Source::Type type )
+	{
+		switch( type )
+		{
+			case Como::Source::Int :
+				return QVariant( get< qint32 > () );
+			case Como::Source::UInt :
+				return QVariant( get< quint32 > () );
+			case Como::Source::LongLong :
+				return QVariant( get< qint64 > () );
+			case Como::Source::ULongLong :
+				return QVariant( get< quint64 > () );
+			case Como::Source::Double :
+				return QVariant( get< double > () );
+			case Como::Source::DateTime :
+				return QVariant( numberToDateTime( get< qint64 > () ) );
+			case Como::Source::Time :
+			{
+				const qint32 msecs = get< qint32 > ();
+
+				return QVariant( msecs < 0 ? QTime() :
+					QTime::fromMSecsSinceStartOfDay( msecs ) );
+			}
+			default :
+				return QVariant( getString() );
+		}
+	}
+
+	//! Read source written with putSource(). \return false on error.
+	bool getSource( Como::Source & source )
+	{
+		const Como::Source::Type type =
+			static_cast< Como::Source::Type > ( get< quint8 > () );
+		const QDateTime dateTime = numberToDateTime( get< qint64 > () );
+		const QString name = getString();
+		const QString typeName = getString();
+		const QString desc = getString();
+		const QVariant value = getValue( type );
+
+		if( !m_isOk )
+			return false;
+
+		source = Como::Source( type, name, typeName, value, desc );
+		source.setDateTime( dateTime );
+
+		return true;
+	}
+
+private:
+	//! Move cursor by \a size bytes. \return false if data is over.
+	bool take( qint64 size )
+	{
+		if( !m_isOk || size > m_left )
+		{
+			m_isOk = false;
+
+			return false;
+		}
+
+		m_data += size;
+		m_left -= size;
+
+		return true;
+	}
+
+private:
+	//! Data.
+	const uchar * m_data;
+	//! Bytes left in the data.
+	qint64 m_left;
+	//! Were all reads inside of the data?
+	bool m_isOk;
+}; // class SourceCursor
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCE_CODEC_HPP__INCLUDED
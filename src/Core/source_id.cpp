@@ -0,0 +1,280 @@
+
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/source_id.hpp>
+#include <Core/sources_buffer.hpp>
+
+// Qt include.
+#include <QHash>
+#include <QVector>
+#include <QReadWriteLock>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QCoreApplication>
+
+
+namespace Globe {
+
+//
+// SourceIdsEntry
+//
+
+//! Strings of the interned source.
+class SourceIdsEntry {
+public:
+	SourceIdsEntry()
+		:	m_pins( 0 )
+	{
+	}
+
+	SourceIdsEntry( const QString & channelName, const QString & typeName,
+		const QString & name )
+		:	m_channelName( channelName )
+		,	m_typeName( typeName )
+		,	m_name( name )
+		,	m_pins( 0 )
+	{
+	}
+
+	//! Channel's name.
+	QString m_channelName;
+	//! Type name.
+	QString m_typeName;
+	//! Name.
+	QString m_name;
+	//! Count of pins.
+	int m_pins;
+}; // class SourceIdsEntry
+
+
+//
+// SourceIdsPrivate
+//
+
+class SourceIdsPrivate {
+public:
+	SourceIdsPrivate()
+	{
+	}
+
+	//! \return Identifier or c_invalidSourceId. Should be called under lock.
+	SourceId find( const QString & channelName, const SourceKey & key ) const
+	{
+		const auto it = m_ids.constFind( channelName );
+
+		if( it != m_ids.cend() )
+			return it.value().value( key, c_invalidSourceId );
+		else
+			return c_invalidSourceId;
+	}
+
+	//! \return Entry of the identifier. Should be called under lock.
+	const SourceIdsEntry & entry( SourceId id ) const
+	{
+		static const SourceIdsEntry dummy;
+
+		if( id != c_invalidSourceId && id <= (SourceId) m_entries.size() )
+			return m_entries.at( id - 1 );
+		else
+			return dummy;
+	}
+
+	//! Identifiers of the sources by channels.
+	QHash< QString, QHash< SourceKey, SourceId > > m_ids;
+	//! Entries, entry of the identifier is at index ( id - 1 ).
+	QVector< SourceIdsEntry > m_entries;
+	//! Released identifiers.
+	QVector< SourceId > m_free;
+	//! Lock.
+	mutable QReadWriteLock m_lock;
+}; // class SourceIdsPrivate
+
+
+//
+// SourceIds
+//
+
+SourceIds::SourceIds()
+	:	d( new SourceIdsPrivate )
+{
+}
+
+SourceIds::~SourceIds()
+{
+}
+
+static SourceIds * sourceIdsInstancePointer = 0;
+
+void
+SourceIds::cleanup()
+{
+	delete sourceIdsInstancePointer;
+
+	sourceIdsInstancePointer = 0;
+}
+
+SourceIds &
+SourceIds::instance()
+{
+	if( !sourceIdsInstancePointer )
+	{
+		sourceIdsInstancePointer = new SourceIds;
+
+		qAddPostRoutine( &SourceIds::cleanup );
+	}
+
+	return *sourceIdsInstancePointer;
+}
+
+SourceId
+SourceIds::id( const QString & channelName, const Como::Source & source )
+{
+	return id( channelName, source.typeName(), source.name() );
+}
+
+SourceId
+SourceIds::id( const QString & channelName, const QString & typeName,
+	const QString & name )
+{
+	const SourceKey key( name, typeName );
+
+	{
+		QReadLocker lock( &d->m_lock );
+
+		const SourceId id = d->find( channelName, key );
+
+		if( id != c_invalidSourceId )
+			return id;
+	}
+
+	QWriteLocker lock( &d->m_lock );
+
+	SourceId id = d->find( channelName, key );
+
+	if( id == c_invalidSourceId )
+	{
+		if( !d->m_free.isEmpty() )
+		{
+			id = d->m_free.takeLast();
+
+			d->m_entries[ id - 1 ] =
+				SourceIdsEntry( channelName, typeName, name );
+		}
+		else
+		{
+			d->m_entries.append(
+				SourceIdsEntry( channelName, typeName, name ) );
+
+			id = d->m_entries.size();
+		}
+
+		d->m_ids[ channelName ].insert( key, id );
+	}
+
+	return id;
+}
+
+SourceId
+SourceIds::find( const QString & channelName,
+	const Como::Source & source ) const
+{
+	QReadLocker lock( &d->m_lock );
+
+	return d->find( channelName, SourceKey( source ) );
+}
+
+void
+SourceIds::pin( SourceId id )
+{
+	QWriteLocker lock( &d->m_lock );
+
+	if( id != c_invalidSourceId && id <= (SourceId) d->m_entries.size() )
+		++d->m_entries[ id - 1 ].m_pins;
+}
+
+void
+SourceIds::unpin( SourceId id )
+{
+	QWriteLocker lock( &d->m_lock );
+
+	if( id != c_invalidSourceId && id <= (SourceId) d->m_entries.size() &&
+		d->m_entries.at( id - 1 ).m_pins > 0 )
+			--d->m_entries[ id - 1 ].m_pins;
+}
+
+bool
+SourceIds::release( SourceId id )
+{
+	QWriteLocker lock( &d->m_lock );
+
+	if( id == c_invalidSourceId || id > (SourceId) d->m_entries.size() )
+		return false;
+
+	SourceIdsEntry & e = d->m_entries[ id - 1 ];
+
+	if( e.m_pins > 0 || e.m_channelName.isNull() )
+		return false;
+
+	const auto it = d->m_ids.find( e.m_channelName );
+
+	if( it != d->m_ids.end() )
+	{
+		it.value().remove( SourceKey( e.m_name, e.m_typeName ) );
+
+		if( it.value().isEmpty() )
+			d->m_ids.erase( it );
+	}
+
+	e = SourceIdsEntry();
+
+	d->m_free.append( id );
+
+	return true;
+}
+
+QString
+SourceIds::channelName( SourceId id ) const
+{
+	QReadLocker lock( &d->m_lock );
+
+	return d->entry( id ).m_channelName;
+}
+
+QString
+SourceIds::typeName( SourceId id ) const
+{
+	QReadLocker lock( &d->m_lock );
+
+	return d->entry( id ).m_typeName;
+}
+
+QString
+SourceIds::name( SourceId id ) const
+{
+	QReadLocker lock( &d->m_lock );
+
+	return d->entry( id ).m_name;
+}
+
+} /* namespace Globe */
@@ -0,0 +1,129 @@
+
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__SOURCE_ID_HPP__INCLUDED
+#define GLOBE__SOURCE_ID_HPP__INCLUDED
+
+// Qt include.
+#include <QScopedPointer>
+#include <QString>
+
+// Como include.
+#include <Como/Source>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//! Compact identifier of the source in the channel.
+typedef quint32 SourceId;
+
+//! Invalid identifier of the source.
+static const SourceId c_invalidSourceId = 0;
+
+
+//
+// SourceIds
+//
+
+class SourceIdsPrivate;
+
+/*!
+	Interning of the sources. Channel's name, type name and name of the
+	source are mapped to the compact integer identifier only once, and
+	then the identifier is used as the key instead of strings.
+
+	Identifier is released by the sources manager when the source is
+	evicted and can be reused for another source then. Identifiers
+	kept by long living objects, i.e. items of the scheme, should be
+	pinned, pinned identifier is never released.
+
+	\note This class is thread-safe.
+*/
+class CORE_EXPORT SourceIds {
+private:
+	SourceIds();
+
+	~SourceIds();
+
+	static void cleanup();
+
+public:
+	//! \return Instance.
+	static SourceIds & instance();
+
+	/*!
+		\return Identifier of the source in the given channel.
+
+		New identifier is allocated for the unknown source.
+	*/
+	SourceId id( const QString & channelName, const Como::Source & source );
+
+	/*!
+		\return Identifier of the source in the given channel.
+
+		New identifier is allocated for the unknown source.
+	*/
+	SourceId id( const QString & channelName, const QString & typeName,
+		const QString & name );
+
+	/*!
+		\return Identifier of the source in the given channel or
+		c_invalidSourceId if the source is unknown.
+	*/
+	SourceId find( const QString & channelName,
+		const Como::Source & source ) const;
+
+	//! Pin identifier, so it will not be released.
+	void pin( SourceId id );
+
+	//! Unpin identifier.
+	void unpin( SourceId id );
+
+	/*!
+		Release identifier, so it can be reused for another source.
+
+		\return Is identifier released? Pinned identifier is not.
+	*/
+	bool release( SourceId id );
+
+	//! \return Channel's name of the source with the given identifier.
+	QString channelName( SourceId id ) const;
+
+	//! \return Type name of the source with the given identifier.
+	QString typeName( SourceId id ) const;
+
+	//! \return Name of the source with the given identifier.
+	QString name( SourceId id ) const;
+
+private:
+	Q_DISABLE_COPY( SourceIds )
+
+	QScopedPointer< SourceIdsPrivate > d;
+}; // class SourceIds
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCE_ID_HPP__INCLUDED
@@ -30,67 +30,90 @@
 // Qt include.
 #include <QMap>
 #include <QList>
+#include <QVector>
+#include <QSet>
+#include <QTimer>
+#include <QElapsedTimer>
 #include <QCoreApplication>
 
+// C++ include.
+#include <algorithm>
+
 
 namespace Globe {
 
+//! Max interval of the check of the age of deregistered sources in seconds.
+static const int c_retentionCheckInterval = 60;
+
+
 //
 // MapValue.
 //
 
-//! Value in the map of sources.
+//! Current state of the source in the store.
 class MapValue {
 public:
 	MapValue()
 		:	m_registered( false )
+		,	m_version( 0 )
+		,	m_deregisteredAt( 0 )
+		,	m_stale( false )
 	{
 	}
 
-	explicit MapValue( const Como::Source & source, bool registered = true )
-		:	m_source( source )
-		,	m_registered( registered )
+	//! \return Source.
+	const Como::Source & source() const
 	{
+		return m_source;
 	}
-
-	MapValue( const MapValue & other )
-		:	m_source( other.source() )
-		,	m_registered( other.isRegistered() )
+	//! Set source.
+	void setSource( const Como::Source & s )
 	{
+		m_source = s;
 	}
 
-	MapValue & operator = ( const MapValue & other )
+	//! \return Is registered?
+	bool isRegistered() const
 	{
-		if( this != &other )
-		{
-			m_source = other.source();
-			m_registered = other.isRegistered();
-		}
-
-		return *this;
+		return m_registered;
+	}
+	//! Set "is registered".
+	void setRegistered( bool on = true )
+	{
+		m_registered = on;
 	}
 
-	//! \return Source.
-	Como::Source & source()
+	//! \return Version, 0 if there is no such source in the store.
+	quint64 version() const
 	{
-		return m_source;
+		return m_version;
+	}
+	//! Set version.
+	void setVersion( quint64 v )
+	{
+		m_version = v;
 	}
 
-	//! \return Source.
-	const Como::Source & source() const
+	//! \return Time of the deregistration.
+	qint64 deregisteredAt() const
 	{
-		return m_source;
+		return m_deregisteredAt;
+	}
+	//! Set time of the deregistration.
+	void setDeregisteredAt( qint64 t )
+	{
+		m_deregisteredAt = t;
 	}
 
-	//! \return Is registered?
-	bool isRegistered() const
+	//! \return Is value restored from the snapshot and not updated since?
+	bool isStale() const
 	{
-		return m_registered;
+		return m_stale;
 	}
-	//! Set "is registered".
-	void setRegistered( bool on = true )
+	//! Set "is stale".
+	void setStale( bool on = true )
 	{
-		m_registered = on;
+		m_stale = on;
 	}
 
 private:
@@ -98,12 +121,131 @@ private:
 	Como::Source m_source;
 	//! Is registered?
 	bool m_registered;
+	//! Version.
+	quint64 m_version;
+	//! Time of the deregistration, milliseconds of the manager's clock.
+	qint64 m_deregisteredAt;
+	//! Is value restored from the snapshot and not updated since?
+	bool m_stale;
 }; // class MapValue
 
-bool operator == ( const MapValue & v1, const MapValue & v2 )
-{
-	return v1.source() == v2.source();
-}
+
+//
+// SourcesIndex
+//
+
+/*!
+	Sources of the channel. Identifiers are kept in the order of
+	appearance of the sources, only deregistered sources are removed
+	by the retention policy. Values of the sources are in the store
+	of the manager.
+*/
+class SourcesIndex {
+public:
+	SourcesIndex()
+		:	m_registeredCount( 0 )
+	{
+	}
+
+	//! Append identifier of the new source.
+	void append( SourceId id, bool registered )
+	{
+		m_ids.append( id );
+
+		if( registered )
+			++m_registeredCount;
+	}
+
+	//! Registration state of one of the sources changed.
+	void registrationChanged( bool registered )
+	{
+		if( registered )
+			++m_registeredCount;
+		else
+			--m_registeredCount;
+	}
+
+	//! All sources deregistered.
+	void allDeregistered()
+	{
+		m_registeredCount = 0;
+	}
+
+	//! Source deregistered, version is the version of the deregistration.
+	void deregistered( SourceId id, quint64 version )
+	{
+		m_lru.insert( version, id );
+	}
+
+	//! Source deregistered with the given version registered again.
+	void reregistered( quint64 version )
+	{
+		m_lru.remove( version );
+	}
+
+	//! \return Deregistered sources from the least recently deregistered.
+	QMap< quint64, SourceId > & lru()
+	{
+		return m_lru;
+	}
+
+	//! Source changed, \a previous is it's previous version or 0.
+	void changed( SourceId id, quint64 previous, quint64 version )
+	{
+		if( previous != 0 )
+			m_changes.remove( previous );
+
+		m_changes.insert( version, id );
+	}
+
+	//! Source with the given version is removed.
+	void forget( quint64 version )
+	{
+		m_changes.remove( version );
+	}
+
+	//! \return Sources by the version of the last change.
+	const QMap< quint64, SourceId > & changes() const
+	{
+		return m_changes;
+	}
+
+	//! Remove evicted sources.
+	void remove( const QSet< SourceId > & evicted )
+	{
+		m_ids.erase( std::remove_if( m_ids.begin(), m_ids.end(),
+			[&evicted] ( SourceId id ) { return evicted.contains( id ); } ),
+			m_ids.end() );
+	}
+
+	//! \return Identifiers.
+	const QVector< SourceId > & ids() const
+	{
+		return m_ids;
+	}
+
+	//! \return Count of registered sources.
+	int registeredCount() const
+	{
+		return m_registeredCount;
+	}
+
+	//! \return Count of deregistered sources.
+	int deregisteredCount() const
+	{
+		return m_ids.size() - m_registeredCount;
+	}
+
+private:
+	//! Identifiers of the sources.
+	QVector< SourceId > m_ids;
+	//! Count of registered sources.
+	int m_registeredCount;
+	//! Deregistered sources by the version of the deregistration.
+	QMap< quint64, SourceId > m_lru;
+	//! All sources by the version of the last change.
+	QMap< quint64, SourceId > m_changes;
+}; // class SourcesIndex
 
 
 //
@@ -113,67 +255,421 @@ bool operator == ( const MapValue & v1, const MapValue & v2 )
 class SourcesManagerPrivate {
 public:
 	SourcesManagerPrivate( )
+		:	m_version( 0 )
+		,	m_epoch( 0 )
+		,	m_maxAge( 0 )
+		,	m_maxCount( 0 )
 	{
+		m_clock.start();
 	}
 
-	//! \return Registered sources.
-	QList< Como::Source > registeredSources( const QString & channelName )
+	//! \return Value of the source, 0 if there is no such source.
+	const MapValue * find( SourceId id ) const
 	{
-		QList< Como::Source > result;
+		if( id != c_invalidSourceId && id <= (SourceId) m_store.size() &&
+			m_store.at( id - 1 ).version() != 0 )
+				return &m_store.at( id - 1 );
+		else
+			return 0;
+	}
 
-		QMap< QString, QList< MapValue > >::ConstIterator it =
-			m_map.find( channelName );
+	//! \return Value of the source, store grows if needed.
+	MapValue & value( SourceId id )
+	{
+		if( id > (SourceId) m_store.size() )
+		{
+			if( id > (SourceId) m_store.capacity() )
+				m_store.reserve( qMax( (int) id, m_store.capacity() * 2 ) );
 
-		if( it != m_map.cend() )
+			m_store.resize( id );
+		}
+
+		return m_store[ id - 1 ];
+	}
+
+	/*!
+		Update or register source.
+
+		\return Is it a new source?
+	*/
+	bool update( SourcesIndex & index, SourceId id,
+		const Como::Source & source )
+	{
+		MapValue & v = value( id );
+
+		const bool isNew = ( v.version() == 0 );
+
+		if( isNew )
+			index.append( id, true );
+		else if( !v.isRegistered() )
 		{
-			foreach( const MapValue & value, it.value() )
-				if( value.isRegistered() )
-					result.append( value.source() );
+			index.registrationChanged( true );
+			index.reregistered( v.version() );
 		}
 
-		return result;
+		v.setSource( source );
+		v.setRegistered( true );
+		v.setStale( false );
+		stamp( index, id, v );
+
+		return isNew;
+	}
+
+	/*!
+		Deregister source.
+
+		\return Is it a new source?
+	*/
+	bool deregister( SourcesIndex & index, SourceId id,
+		const Como::Source & source )
+	{
+		MapValue & v = value( id );
+
+		if( v.version() == 0 )
+		{
+			index.append( id, false );
+
+			v.setSource( source );
+			v.setRegistered( false );
+			setDeregistered( index, id, v );
+
+			return true;
+		}
+		else
+		{
+			if( v.isStale() )
+			{
+				v.setSource( source );
+				v.setStale( false );
+
+				// Live deregistration of the restored deregistered source.
+				if( !v.isRegistered() )
+				{
+					index.reregistered( v.version() );
+					setDeregistered( index, id, v );
+				}
+			}
+
+			if( v.isRegistered() )
+			{
+				index.registrationChanged( false );
+
+				v.setRegistered( false );
+				setDeregistered( index, id, v );
+			}
+
+			return false;
+		}
+	}
+
+	/*!
+		Restore source from the snapshot, known source is not changed.
+
+		\return Is it a new source?
+	*/
+	bool restore( SourcesIndex & index, SourceId id,
+		const Como::Source & source, bool registered )
+	{
+		MapValue & v = value( id );
+
+		if( v.version() != 0 )
+			return false;
+
+		index.append( id, registered );
+
+		v.setSource( source );
+		v.setRegistered( registered );
+		v.setStale( true );
+
+		if( registered )
+			stamp( index, id, v );
+		else
+			setDeregistered( index, id, v );
+
+		return true;
+	}
+
+	//! Deregister all sources of the channel.
+	void deregisterAll( SourcesIndex & index )
+	{
+		for( const SourceId id : index.ids() )
+		{
+			MapValue & v = m_store[ id - 1 ];
+
+			if( v.isRegistered() )
+			{
+				v.setRegistered( false );
+				setDeregistered( index, id, v );
+			}
+		}
+
+		index.allDeregistered();
+	}
+
+	//! Deregister registered sources restored from the snapshot.
+	void deregisterStale( SourcesIndex & index )
+	{
+		for( const SourceId id : index.ids() )
+		{
+			MapValue & v = m_store[ id - 1 ];
+
+			if( v.isRegistered() && v.isStale() )
+			{
+				index.registrationChanged( false );
+
+				v.setRegistered( false );
+				setDeregistered( index, id, v );
+			}
+		}
+	}
+
+	//! Stamp new version of the source.
+	void stamp( SourcesIndex & index, SourceId id, MapValue & v )
+	{
+		const quint64 previous = v.version();
+
+		v.setVersion( ++m_version );
+
+		index.changed( id, previous, v.version() );
+	}
+
+	//! Stamp deregistration of the source.
+	void setDeregistered( SourcesIndex & index, SourceId id, MapValue & v )
+	{
+		stamp( index, id, v );
+		v.setDeregisteredAt( m_clock.elapsed() );
+
+		index.deregistered( id, v.version() );
+	}
+
+	/*!
+		Evict least recently deregistered sources of the channel by
+		the retention policy.
+
+		\return Last values of the evicted sources, their identifiers
+		are in \a ids.
+	*/
+	QVector< Como::Source > evict( SourcesIndex & index,
+		QVector< SourceId > & ids )
+	{
+		QVector< Como::Source > evicted;
+
+		if( m_maxAge <= 0 && m_maxCount <= 0 )
+			return evicted;
+
+		const qint64 now = m_clock.elapsed();
+
+		int count = index.deregisteredCount();
+
+		QMap< quint64, SourceId > & lru = index.lru();
+
+		QMap< quint64, SourceId >::Iterator it = lru.begin();
+
+		while( it != lru.end() )
+		{
+			MapValue & v = m_store[ it.value() - 1 ];
+
+			const bool tooMany = ( m_maxCount > 0 && count > m_maxCount );
+			const bool tooOld = ( m_maxAge > 0 &&
+				now - v.deregisteredAt() > qint64( m_maxAge ) * 1000 );
+
+			if( !tooMany && !tooOld )
+				break;
+
+			ids.append( it.value() );
+			evicted.append( v.source() );
+
+			index.forget( v.version() );
+
+			v = MapValue();
+
+			--count;
+
+			it = lru.erase( it );
+		}
+
+		if( !ids.isEmpty() )
+		{
+			index.remove( QSet< SourceId >( ids.cbegin(), ids.cend() ) );
+
+			++m_epoch;
+		}
+
+		return evicted;
+	}
+
+	/*!
+		Remove all sources of the channel from the store.
+
+		\return Last values of the removed sources.
+	*/
+	QVector< Como::Source > remove( const SourcesIndex & index )
+	{
+		QVector< Como::Source > removed;
+		removed.reserve( index.ids().size() );
+
+		for( const SourceId id : index.ids() )
+		{
+			MapValue & v = m_store[ id - 1 ];
+
+			removed.append( v.source() );
+
+			v = MapValue();
+		}
+
+		++m_epoch;
+
+		return removed;
+	}
+
+	/*!
+		Release identifiers of the removed sources, slots of the
+		released identifiers in the store go to new sources.
+	*/
+	void release( const QVector< SourceId > & ids )
+	{
+		for( const SourceId id : ids )
+		{
+			if( SourceIds::instance().release( id ) )
+				PropertiesManager::instance().forgetSource( id );
+		}
 	}
 
-	//! \return Deregistered sources.
-	QList< Como::Source > deregisteredSources( const QString & channelName )
+	//! \return Sources with the given registration state.
+	QList< Como::Source > sources( const QString & channelName,
+		bool registered ) const
 	{
 		QList< Como::Source > result;
 
-		QMap< QString, QList< MapValue > >::ConstIterator it =
-			m_map.find( channelName );
+		QMap< QString, SourcesIndex >::ConstIterator it =
+			m_map.constFind( channelName );
 
 		if( it != m_map.cend() )
 		{
-			foreach( const MapValue & value, it.value() )
-				if( !value.isRegistered() )
-					result.append( value.source() );
+			result.reserve( registered ? it.value().registeredCount() :
+				it.value().deregisteredCount() );
+
+			for( const SourceId id : it.value().ids() )
+			{
+				const MapValue & v = m_store.at( id - 1 );
+
+				if( v.isRegistered() == registered )
+					result.append( v.source() );
+			}
 		}
 
 		return result;
 	}
 
 	//! \return All sources.
-	QList< Como::Source > allSources( const QString & channelName )
+	QList< Como::Source > allSources( const QString & channelName ) const
 	{
 		QList< Como::Source > result;
 
-		QMap< QString, QList< MapValue > >::ConstIterator it =
-			m_map.find( channelName );
+		QMap< QString, SourcesIndex >::ConstIterator it =
+			m_map.constFind( channelName );
 
 		if( it != m_map.cend() )
 		{
-			foreach( const MapValue & value, it.value() )
-				result.append( value.source() );
+			result.reserve( it.value().ids().size() );
+
+			for( const SourceId id : it.value().ids() )
+				result.append( m_store.at( id - 1 ).source() );
 		}
 
 		return result;
 	}
 
-	//! Map of registered sources.
-	QMap< QString, QList< MapValue > > m_map;
+	//! Sources of the channels.
+	QMap< QString, SourcesIndex > m_map;
+	//! Store of the sources, value of the source is at index ( id - 1 ).
+	QVector< MapValue > m_store;
+	//! Last version.
+	quint64 m_version;
+	//! Epoch.
+	quint64 m_epoch;
+	//! Max age of the deregistered source in seconds.
+	int m_maxAge;
+	//! Max count of the deregistered sources per channel.
+	int m_maxCount;
+	//! Clock of the deregistrations.
+	QElapsedTimer m_clock;
+	//! Timer of the check of the age of the deregistered sources.
+	QTimer m_retentionTimer;
 }; // class SourcesManagerPrivate
 
 
+//
+// EvaluatedSource
+//
+
+EvaluatedSource::EvaluatedSource()
+	:	m_id( c_invalidSourceId )
+	,	m_level( None )
+	,	m_priority( 0 )
+{
+}
+
+EvaluatedSource::EvaluatedSource( SourceId id, const Como::Source & source,
+	Level level, int priority, const QString & message )
+	:	m_id( id )
+	,	m_source( source )
+	,	m_level( level )
+	,	m_priority( priority )
+	,	m_message( message )
+{
+}
+
+EvaluatedSource
+EvaluatedSource::evaluate( SourceId id, const Como::Source & source,
+	const QString & channelName )
+{
+	const Properties * props = PropertiesManager::instance().findProperties(
+		id, source, channelName );
+
+	if( props )
+	{
+		const Condition & cond = props->checkConditions( source.value(),
+			source.type() );
+
+		return EvaluatedSource( id, source, cond.level(), props->priority(),
+			cond.message() );
+	}
+	else
+		return EvaluatedSource( id, source, None, 0, QString() );
+}
+
+SourceId
+EvaluatedSource::id() const
+{
+	return m_id;
+}
+
+const Como::Source &
+EvaluatedSource::source() const
+{
+	return m_source;
+}
+
+Level
+EvaluatedSource::level() const
+{
+	return m_level;
+}
+
+int
+EvaluatedSource::priority() const
+{
+	return m_priority;
+}
+
+const QString &
+EvaluatedSource::message() const
+{
+	return m_message;
+}
+
+
 //
 // SourcesManager.
 //
@@ -187,6 +683,9 @@ SourcesManager::SourcesManager( QObject * parent )
 
 	connect( &ChannelsManager::instance(), &ChannelsManager::channelRemoved,
 		this, &SourcesManager::channelRemoved );
+
+	connect( &d->m_retentionTimer, &QTimer::timeout,
+		this, &SourcesManager::evictExpiredSources );
 }
 
 SourcesManager::~SourcesManager()
@@ -231,81 +730,227 @@ SourcesManager::sources( const QString & channelName ) const
 QList< Como::Source >
 SourcesManager::registeredSources( const QString & channelName ) const
 {
-	return d->registeredSources( channelName );
+	return d->sources( channelName, true );
 }
 
 QList< Como::Source >
 SourcesManager::deregisteredSources( const QString & channelName ) const
 {
-	return d->deregisteredSources( channelName );
+	return d->sources( channelName, false );
 }
 
-bool
-SourcesManager::syncSource( const QString & channelName,
-	Como::Source & s, bool & isRegistered )
+void
+SourcesManager::forEachSource( const QString & channelName,
+	const SourcesVisitor & visitor ) const
 {
-	if( d->m_map.contains( channelName ) )
+	QMap< QString, SourcesIndex >::ConstIterator it =
+		d->m_map.constFind( channelName );
+
+	if( it != d->m_map.cend() )
 	{
-		foreach( const MapValue & v, d->m_map[ channelName ] )
+		for( const SourceId id : it.value().ids() )
 		{
-			if( v.source() == s )
-			{
-				s = v.source();
-				isRegistered = v.isRegistered();
+			const MapValue & v = d->m_store.at( id - 1 );
 
-				return true;
-			}
+			visitor( id, v.source(), v.isRegistered() );
 		}
 	}
+}
 
-	return false;
+const Como::Source *
+SourcesManager::findSource( SourceId id ) const
+{
+	const MapValue * v = d->find( id );
+
+	return ( v ? &v->source() : 0 );
 }
 
-void
-SourcesManager::sourceUpdated( const Como::Source & source )
+const Como::Source &
+SourcesManager::source( SourceId id ) const
 {
-	Channel * channel = static_cast< Channel* > ( sender() );
+	static const Como::Source dummy;
 
-	QMap< QString, QList< MapValue > >::Iterator it =
-		d->m_map.find( channel->name() );
+	if( id != c_invalidSourceId && id <= (SourceId) d->m_store.size() )
+		return d->m_store.at( id - 1 ).source();
+	else
+		return dummy;
+}
 
-	Log::instance().writeMsgToSourcesLog( source.dateTime(),
-		channel->name(), source.type(), source.name(),
-		source.typeName(), source.value(), source.description() );
+bool
+SourcesManager::isRegistered( SourceId id ) const
+{
+	const MapValue * v = d->find( id );
 
-	if( it != d->m_map.end() )
+	return ( v ? v->isRegistered() : false );
+}
+
+quint64
+SourcesManager::version( SourceId id ) const
+{
+	const MapValue * v = d->find( id );
+
+	return ( v ? v->version() : 0 );
+}
+
+bool
+SourcesManager::isStale( SourceId id ) const
+{
+	const MapValue * v = d->find( id );
+
+	return ( v ? v->isStale() : false );
+}
+
+quint64
+SourcesManager::lastVersion() const
+{
+	return d->m_version;
+}
+
+quint64
+SourcesManager::epoch() const
+{
+	return d->m_epoch;
+}
+
+void
+SourcesManager::forEachChangedSource( const QString & channelName,
+	quint64 since, const SourcesVisitor & visitor ) const
+{
+	if( since >= d->m_version )
+		return;
+
+	QMap< QString, SourcesIndex >::ConstIterator it =
+		d->m_map.constFind( channelName );
+
+	if( it != d->m_map.cend() )
 	{
-		const int index = it.value().indexOf( MapValue( source ) );
+		const QMap< quint64, SourceId > & changes = it.value().changes();
 
-		if( index != -1 )
-			it.value()[ index ] = MapValue( source );
-		else
+		for( auto cit = changes.upperBound( since ), last = changes.cend();
+			cit != last; ++cit )
 		{
-			it.value().append( MapValue( source ) );
+			const MapValue & v = d->m_store.at( cit.value() - 1 );
 
-			emit newSource( source, channel->name() );
+			visitor( cit.value(), v.source(), v.isRegistered() );
 		}
 	}
+}
+
+int
+SourcesManager::registeredSourcesCount( const QString & channelName ) const
+{
+	QMap< QString, SourcesIndex >::ConstIterator it =
+		d->m_map.constFind( channelName );
+
+	return ( it != d->m_map.cend() ? it.value().registeredCount() : 0 );
+}
+
+int
+SourcesManager::deregisteredSourcesCount( const QString & channelName ) const
+{
+	QMap< QString, SourcesIndex >::ConstIterator it =
+		d->m_map.constFind( channelName );
+
+	return ( it != d->m_map.cend() ? it.value().deregisteredCount() : 0 );
+}
+
+void
+SourcesManager::setRetentionPolicy( int maxAge, int maxCount )
+{
+	d->m_maxAge = qMax( 0, maxAge );
+	d->m_maxCount = qMax( 0, maxCount );
+
+	if( d->m_maxAge > 0 )
+		d->m_retentionTimer.start(
+			qMin( d->m_maxAge, c_retentionCheckInterval ) * 1000 );
 	else
+		d->m_retentionTimer.stop();
+
+	evictExpiredSources();
+}
+
+void
+SourcesManager::restoreSource( const QString & channelName,
+	const Como::Source & source, bool isRegistered )
+{
+	QMap< QString, SourcesIndex >::Iterator it =
+		d->m_map.find( channelName );
+
+	if( it == d->m_map.end() )
+		it = d->m_map.insert( channelName, SourcesIndex() );
+
+	if( d->restore( it.value(), SourceIds::instance().id( channelName, source ),
+		source, isRegistered ) )
+	{
+		emit newSource( source, channelName );
+
+		if( !isRegistered )
+			evictSources( channelName );
+	}
+}
+
+void
+SourcesManager::removeOrphanedChannels()
+{
+	const QList< QString > channels = d->m_map.keys();
+
+	for( const auto & name : channels )
+	{
+		if( !ChannelsManager::instance().channelByName( name ) )
+			removeSources( name );
+	}
+}
+
+bool
+SourcesManager::syncSource( const QString & channelName,
+	Como::Source & s, bool & isRegistered )
+{
+	const MapValue * v = d->find( SourceIds::instance().find( channelName, s ) );
+
+	if( v )
 	{
-		QMap< QString, QList< MapValue > >::Iterator it =
-			d->m_map.insert( channel->name(), QList< MapValue > () );
+		s = v->source();
+		isRegistered = v->isRegistered();
 
-		it.value().append( MapValue( source ) );
+		return true;
 	}
 
+	return false;
+}
+
+void
+SourcesManager::sourcesUpdated( const QVector< Como::Source > & sources )
+{
+	Channel * channel = static_cast< Channel* > ( sender() );
+
 	const QString channelName = channel->name();
 
-	const Properties * props = PropertiesManager::instance().findProperties(
-		source, channelName, 0 );
+	Log::instance().writeMsgsToSourcesLog( channelName, sources );
 
-	if( props )
+	QMap< QString, SourcesIndex >::Iterator it =
+		d->m_map.find( channelName );
+
+	if( it == d->m_map.end() )
+		it = d->m_map.insert( channelName, SourcesIndex() );
+
+	QVector< EvaluatedSource > evaluated;
+	evaluated.reserve( sources.size() );
+
+	for( const auto & source : sources )
 	{
-		Level level = props->checkConditions( source.value(),
-			source.type() ).level();
+		const SourceId id = SourceIds::instance().id( channelName, source );
 
-		Sounds::instance().playSound( level, source, channelName );
+		if( d->update( it.value(), id, source ) )
+			emit newSource( source, channelName );
+
+		evaluated.append( EvaluatedSource::evaluate( id, source, channelName ) );
+
+		if( evaluated.last().level() != None )
+			Sounds::instance().playSound( evaluated.last().level(),
+				source, channelName );
 	}
+
+	emit sourcesEvaluated( evaluated, channelName );
 }
 
 void
@@ -313,43 +958,42 @@ SourcesManager::sourceDeregistered( const Como::Source & source )
 {
 	Channel * channel = static_cast< Channel* > ( sender() );
 
-	QMap< QString, QList< MapValue > >::Iterator it =
+	const SourceId id = SourceIds::instance().id( channel->name(), source );
+
+	QMap< QString, SourcesIndex >::Iterator it =
 		d->m_map.find( channel->name() );
 
 	if( it != d->m_map.end() )
 	{
-		const int index = it.value().indexOf( MapValue( source ) );
-
-		if( index != -1 )
-			it.value()[ index ].setRegistered( false );
-		else
-		{
-			it.value().append( MapValue( source, false ) );
-
+		if( d->deregister( it.value(), id, source ) )
 			emit newSource( source, channel->name() );
-		}
 	}
 	else
 	{
-		QMap< QString, QList< MapValue > >::Iterator it =
-			d->m_map.insert( channel->name(), QList< MapValue > () );
+		QMap< QString, SourcesIndex >::Iterator it =
+			d->m_map.insert( channel->name(), SourcesIndex() );
 
-		it.value().append( MapValue( source, false ) );
+		d->deregister( it.value(), id, source );
 	}
+
+	evictSources( channel->name() );
 }
 
 void
 SourcesManager::channelCreated( Globe::Channel * channel )
 {
 	if( d->m_map.find( channel->name() ) == d->m_map.end() )
-		d->m_map.insert( channel->name(), QList< MapValue > () );
+		d->m_map.insert( channel->name(), SourcesIndex() );
 
-	connect( channel, &Channel::sourceUpdated,
-		this, &SourcesManager::sourceUpdated );
+	connect( channel, &Channel::sourcesUpdated,
+		this, &SourcesManager::sourcesUpdated );
 
 	connect( channel, &Channel::sourceDeregistered,
 		this, &SourcesManager::sourceDeregistered );
 
+	connect( channel, &Channel::connected,
+		this, &SourcesManager::channelConnected );
+
 	connect( channel, &Channel::disconnected,
 		this, &SourcesManager::channelDisconnected );
 }
@@ -357,21 +1001,89 @@ SourcesManager::channelCreated( Globe::Channel * channel )
 void
 SourcesManager::channelRemoved( Globe::Channel * channel )
 {
-	d->m_map.remove( channel->name() );
+	removeSources( channel->name() );
 
 	disconnect( channel, 0, 0, 0 );
 }
 
+void
+SourcesManager::channelConnected()
+{
+	Channel * channel = static_cast< Channel* > ( sender() );
+
+	QMap< QString, SourcesIndex >::Iterator it =
+		d->m_map.find( channel->name() );
+
+	if( it != d->m_map.end() )
+	{
+		d->deregisterStale( it.value() );
+
+		evictSources( channel->name() );
+	}
+}
+
 void
 SourcesManager::channelDisconnected()
 {
 	Channel * channel = static_cast< Channel* > ( sender() );
 
-	QList< MapValue > & sources = d->m_map[ channel->name() ];
+	d->deregisterAll( d->m_map[ channel->name() ] );
+
+	evictSources( channel->name() );
+}
+
+void
+SourcesManager::evictExpiredSources()
+{
+	const QList< QString > channels = d->m_map.keys();
+
+	for( const auto & name : channels )
+		evictSources( name );
+}
+
+void
+SourcesManager::removeSources( const QString & channelName )
+{
+	QMap< QString, SourcesIndex >::Iterator it =
+		d->m_map.find( channelName );
+
+	if( it != d->m_map.end() )
+	{
+		const QVector< SourceId > ids = it.value().ids();
+		const QVector< Como::Source > removed = d->remove( it.value() );
+
+		d->m_map.erase( it );
+
+		if( !removed.isEmpty() )
+		{
+			emit sourcesEvicted( removed, channelName );
+
+			d->release( ids );
+		}
+	}
+}
+
+void
+SourcesManager::evictSources( const QString & channelName )
+{
+	QMap< QString, SourcesIndex >::Iterator it =
+		d->m_map.find( channelName );
+
+	if( it != d->m_map.end() )
+	{
+		QVector< SourceId > ids;
+
+		const QVector< Como::Source > evicted = d->evict( it.value(), ids );
+
+		if( !evicted.isEmpty() )
+		{
+			emit sourcesEvicted( evicted, channelName );
 
-	for( QList< MapValue >::Iterator it = sources.begin(),
-		last = sources.end(); it != last; ++it )
-			it->setRegistered( false );
+			// Views find evicted sources by their identifiers, so
+			// identifiers are released only after the signal.
+			d->release( ids );
+		}
+	}
 }
 
 } /* namespace Globe */
@@ -25,25 +25,94 @@
 
 // Qt include.
 #include <QObject>
+#include <QVector>
 
 // Como include.
 #include <Como/Source>
 
+// C++ include.
+#include <functional>
+
+// Globe include.
+#include <Core/export.hpp>
+#include <Core/condition.hpp>
+#include <Core/source_id.hpp>
+
 
 namespace Globe {
 
 class Channel;
 
+
+//
+// EvaluatedSource
+//
+
+/*!
+	Source with the result of the evaluation of its properties, i.e.
+	level and priority of the source and message of the matched
+	condition.
+*/
+class CORE_EXPORT EvaluatedSource {
+public:
+	EvaluatedSource();
+
+	EvaluatedSource( SourceId id, const Como::Source & source, Level level,
+		int priority, const QString & message );
+
+	//! \return Evaluated source with the given identifier in the given channel.
+	static EvaluatedSource evaluate( SourceId id, const Como::Source & source,
+		const QString & channelName );
+
+	//! \return Identifier of the source.
+	SourceId id() const;
+
+	//! \return Source.
+	const Como::Source & source() const;
+
+	//! \return Level of the source.
+	Level level() const;
+
+	//! \return Priority of the source.
+	int priority() const;
+
+	//! \return Message of the matched condition.
+	const QString & message() const;
+
+private:
+	//! Identifier.
+	SourceId m_id;
+	//! Source.
+	Como::Source m_source;
+	//! Level.
+	Level m_level;
+	//! Priority.
+	int m_priority;
+	//! Message.
+	QString m_message;
+}; // class EvaluatedSource
+
 //
 // SourcesManager.
 //
 
 class SourcesManagerPrivate;
 
+/*!
+	Visitor of the sources. Parameters are identifier of the source,
+	Como source and registration state of the source.
+*/
+using SourcesVisitor =
+	std::function< void ( SourceId, const Como::Source &, bool ) >;
+
 /*!
 	Sources manager. Collects information about all sources.
+
+	Manager is the store of the sources: it holds the only current
+	value of each source, views keep identifiers of the sources and
+	read values from the manager.
 */
-class SourcesManager
+class CORE_EXPORT SourcesManager
 	:	public QObject
 {
 	Q_OBJECT
@@ -57,6 +126,26 @@ signals:
 	*/
 	void newSource( const Como::Source &, const QString & );
 
+	/*!
+		Sources updated and evaluated.
+
+		Properties of each source are evaluated once per update,
+		so views should use this result instead of the evaluation
+		on their own. Second parameter is channel's name.
+	*/
+	void sourcesEvaluated( const QVector< Globe::EvaluatedSource > &,
+		const QString & );
+
+	/*!
+		Deregistered sources evicted by the retention policy or all
+		sources of the removed channel.
+
+		First parameter is last values of the evicted sources, they
+		are already removed from the manager. Second parameter is
+		channel's name.
+	*/
+	void sourcesEvicted( const QVector< Como::Source > &, const QString & );
+
 private:
 	SourcesManager( QObject * parent = 0 );
 
@@ -80,21 +169,133 @@ public:
 	//! \return List of deregistered sources in the given channel.
 	QList< Como::Source > deregisteredSources( const QString & channelName ) const;
 
+	/*!
+		Visit all sources in the given channel without copying them.
+
+		Sources are visited in the order of their appearance. Visitor
+		must not modify sources manager.
+	*/
+	void forEachSource( const QString & channelName,
+		const SourcesVisitor & visitor ) const;
+
+	//! \return Count of registered sources in the given channel.
+	int registeredSourcesCount( const QString & channelName ) const;
+
+	//! \return Count of deregistered sources in the given channel.
+	int deregisteredSourcesCount( const QString & channelName ) const;
+
+	/*!
+		\return Current value of the source with the given identifier.
+		\retval NULL if there is no such source.
+
+		Pointer is valid until the next change of the sources.
+	*/
+	const Como::Source * findSource( SourceId id ) const;
+
+	/*!
+		\return Last known value of the source with the given identifier,
+		the source stays known after removal of its channel. Empty
+		source is returned for the unknown source.
+
+		Reference is valid until the next change of the sources.
+	*/
+	const Como::Source & source( SourceId id ) const;
+
+	//! \return Is source with the given identifier registered?
+	bool isRegistered( SourceId id ) const;
+
+	/*!
+		\return Is source with the given identifier stale, i.e.
+		restored from the snapshot and not updated by the channel
+		since then?
+	*/
+	bool isStale( SourceId id ) const;
+
+	/*!
+		\return Version of the source with the given identifier.
+		\retval 0 if there is no such source.
+
+		Version increases every time the source changes.
+	*/
+	quint64 version( SourceId id ) const;
+
+	//! \return Version of the last change of the sources.
+	quint64 lastVersion() const;
+
+	/*!
+		\return Epoch of the sources.
+
+		Epoch changes when sources lose their history, i.e. when a
+		channel is removed or sources are evicted. Versions obtained in the previous epoch
+		can't be used for the delta, view should resync completely.
+	*/
+	quint64 epoch() const;
+
+	/*!
+		Visit sources in the given channel changed after the given
+		version, in the order of their changes. Only changed sources
+		are walked, so the cost doesn't depend on the channel's size.
+
+		Visitor must not modify sources manager.
+	*/
+	void forEachChangedSource( const QString & channelName,
+		quint64 since, const SourcesVisitor & visitor ) const;
+
+	/*!
+		Set retention policy of the deregistered sources.
+
+		Least recently deregistered sources are evicted when they are
+		deregistered more than \a maxAge seconds ago or when there are
+		more than \a maxCount deregistered sources in the channel.
+		0 means unlimited.
+	*/
+	void setRetentionPolicy( int maxAge, int maxCount );
+
+	/*!
+		Restore source from the snapshot.
+
+		Restored source is stale until the channel updates or
+		deregisters it. Already known source is not changed.
+	*/
+	void restoreSource( const QString & channelName,
+		const Como::Source & source, bool isRegistered );
+
+	/*!
+		Remove sources of the channels that aren't in the channels
+		manager, i.e. restored from the snapshot for the channel that
+		is no longer configured.
+	*/
+	void removeOrphanedChannels();
+
 	//! Sync source. \return Was source synced?
 	bool syncSource( const QString & channelName,
 		Como::Source & s, bool & isRegistered );
 
 private slots:
-	//! Source updated or registered.
-	void sourceUpdated( const Como::Source & source );
+	//! Sources updated or registered.
+	void sourcesUpdated( const QVector< Como::Source > & sources );
 	//! Source deregistered.
 	void sourceDeregistered( const Como::Source & source );
 	//! Channel created.
 	void channelCreated( Globe::Channel * channel );
 	//! Channel removed.
 	void channelRemoved( Globe::Channel * channel );
+	/*!
+		Channel connected. Registered sources of the channel restored
+		from the snapshot are deregistered, application will register
+		again only sources it still has.
+	*/
+	void channelConnected();
 	//! Channel disconnected.
 	void channelDisconnected();
+	//! Evict expired sources in all channels.
+	void evictExpiredSources();
+
+private:
+	//! Evict sources in the given channel by the retention policy.
+	void evictSources( const QString & channelName );
+	//! Remove all sources of the channel.
+	void removeSources( const QString & channelName );
 
 private:
 	Q_DISABLE_COPY( SourcesManager )
@@ -0,0 +1,202 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/sources_buffer.hpp>
+
+
+namespace Globe {
+
+//
+// SourceKey
+//
+
+SourceKey::SourceKey()
+{
+}
+
+SourceKey::SourceKey( const Como::Source & source )
+	:	m_name( source.name() )
+	,	m_typeName( source.typeName() )
+{
+}
+
+SourceKey::SourceKey( const QString & name, const QString & typeName )
+	:	m_name( name )
+	,	m_typeName( typeName )
+{
+}
+
+const QString &
+SourceKey::name() const
+{
+	return m_name;
+}
+
+const QString &
+SourceKey::typeName() const
+{
+	return m_typeName;
+}
+
+bool operator == ( const SourceKey & k1, const SourceKey & k2 )
+{
+	return ( k1.name() == k2.name() && k1.typeName() == k2.typeName() );
+}
+
+size_t qHash( const SourceKey & key, size_t seed )
+{
+	return qHashMulti( seed, key.name(), key.typeName() );
+}
+
+
+//
+// SourcesBuffer
+//
+
+SourcesBuffer::SourcesBuffer( int limit )
+	:	m_limit( limit )
+{
+}
+
+int
+SourcesBuffer::limit() const
+{
+	return m_limit;
+}
+
+void
+SourcesBuffer::setLimit( int l )
+{
+	m_limit = l;
+}
+
+int
+SourcesBuffer::size() const
+{
+	return m_index.size();
+}
+
+bool
+SourcesBuffer::isEmpty() const
+{
+	return m_index.isEmpty();
+}
+
+bool
+SourcesBuffer::isFull() const
+{
+	return ( m_limit > 0 && m_index.size() >= m_limit );
+}
+
+bool
+SourcesBuffer::insert( const Como::Source & source )
+{
+	const SourceKey key( source );
+
+	QHash< SourceKey, int >::ConstIterator it = m_index.constFind( key );
+
+	if( it != m_index.cend() )
+	{
+		m_sources[ it.value() ] = source;
+
+		return true;
+	}
+
+	m_index.insert( key, m_sources.size() );
+	m_sources.append( source );
+	m_alive.append( true );
+
+	return false;
+}
+
+bool
+SourcesBuffer::remove( const Como::Source & source )
+{
+	QHash< SourceKey, int >::Iterator it = m_index.find( SourceKey( source ) );
+
+	if( it != m_index.end() )
+	{
+		const int i = it.value();
+
+		m_index.erase( it );
+		m_alive[ i ] = false;
+		m_sources[ i ] = Como::Source();
+
+		if( m_sources.size() - m_index.size() > m_index.size() )
+			compact();
+
+		return true;
+	}
+
+	return false;
+}
+
+QVector< Como::Source >
+SourcesBuffer::takeAll()
+{
+	QVector< Como::Source > result;
+
+	if( m_index.size() == m_sources.size() )
+		result.swap( m_sources );
+	else
+	{
+		result.reserve( m_index.size() );
+
+		for( int i = 0, last = m_sources.size(); i < last; ++i )
+			if( m_alive.at( i ) )
+				result.append( m_sources.at( i ) );
+	}
+
+	clear();
+
+	return result;
+}
+
+void
+SourcesBuffer::clear()
+{
+	m_index.clear();
+	m_sources.clear();
+	m_alive.clear();
+}
+
+void
+SourcesBuffer::compact()
+{
+	QVector< Como::Source > sources;
+	sources.reserve( m_index.size() );
+
+	for( int i = 0, last = m_sources.size(); i < last; ++i )
+	{
+		if( m_alive.at( i ) )
+		{
+			m_index[ SourceKey( m_sources.at( i ) ) ] = sources.size();
+			sources.append( m_sources.at( i ) );
+		}
+	}
+
+	m_sources.swap( sources );
+	m_alive.fill( true, m_sources.size() );
+}
+
+} /* namespace Globe */
@@ -0,0 +1,134 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__SOURCES_BUFFER_HPP__INCLUDED
+#define GLOBE__SOURCES_BUFFER_HPP__INCLUDED
+
+// Qt include.
+#include <QHash>
+#include <QVector>
+#include <QString>
+
+// Como include.
+#include <Como/Source>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//
+// SourceKey
+//
+
+//! Key of the source in the channel (name and type name).
+class CORE_EXPORT SourceKey {
+public:
+	SourceKey();
+
+	explicit SourceKey( const Como::Source & source );
+
+	SourceKey( const QString & name, const QString & typeName );
+
+	//! \return Name of the source.
+	const QString & name() const;
+	//! \return Type name of the source.
+	const QString & typeName() const;
+
+private:
+	//! Name of the source.
+	QString m_name;
+	//! Type name of the source.
+	QString m_typeName;
+}; // class SourceKey
+
+CORE_EXPORT bool operator == ( const SourceKey & k1, const SourceKey & k2 );
+CORE_EXPORT size_t qHash( const SourceKey & key, size_t seed = 0 );
+
+
+//
+// SourcesBuffer
+//
+
+/*!
+	Buffer of the pending updates of the sources in the channel.
+
+	Only the last value of the source is kept. Insertion and
+	overwriting are constant-time, pending sources are taken
+	in the order of their first appearance in the buffer.
+*/
+class CORE_EXPORT SourcesBuffer {
+public:
+	explicit SourcesBuffer( int limit = 0 );
+
+	//! \return Limit of the pending sources. 0 means no limit.
+	int limit() const;
+	//! Set limit of the pending sources.
+	void setLimit( int l );
+
+	//! \return Count of the pending sources.
+	int size() const;
+	//! \return Is buffer empty?
+	bool isEmpty() const;
+	//! \return Is limit of the pending sources reached?
+	bool isFull() const;
+
+	/*!
+		Put source into the buffer.
+
+		\return true if previous value of the source was
+		overwritten.
+	*/
+	bool insert( const Como::Source & source );
+
+	/*!
+		Remove pending value of the source.
+
+		\return Was value of the source pending?
+	*/
+	bool remove( const Como::Source & source );
+
+	//! \return All pending sources and clear buffer.
+	QVector< Como::Source > takeAll();
+
+	//! Clear buffer.
+	void clear();
+
+private:
+	//! Drop removed entries from the storage.
+	void compact();
+
+private:
+	//! Index of the source in the storage.
+	QHash< SourceKey, int > m_index;
+	//! Storage of the pending values.
+	QVector< Como::Source > m_sources;
+	//! Is entry in the storage alive?
+	QVector< bool > m_alive;
+	//! Limit of the pending sources.
+	int m_limit;
+}; // class SourcesBuffer
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_BUFFER_HPP__INCLUDED
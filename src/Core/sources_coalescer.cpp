@@ -0,0 +1,462 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/sources_coalescer.hpp>
+#include <Core/channels.hpp>
+#include <Core/properties.hpp>
+#include <Core/properties_manager.hpp>
+
+// Qt include.
+#include <QTimer>
+
+// C++ include.
+#include <chrono>
+
+
+namespace Globe {
+
+qint64 steadyMSecs()
+{
+	return std::chrono::duration_cast< std::chrono::milliseconds > (
+		std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+qint64 approximateSize( const Como::Source & source )
+{
+	// Type, date-time and lengths of the strings.
+	static const qint64 c_fixedSize = 4 + 8 + 4 * 4;
+
+	qint64 size = c_fixedSize + ( source.name().size() +
+		source.typeName().size() + source.description().size() ) * 2;
+
+	if( source.type() == Como::Source::String )
+		size += source.value().toString().size() * 2;
+	else
+		size += 8;
+
+	return size;
+}
+
+
+//
+// SourcesCoalescer
+//
+
+SourcesCoalescer::SourcesCoalescer( const QString & channelName,
+	QObject * parent )
+	:	QObject( parent )
+	,	m_channelName( channelName )
+	,	m_timeout( 0 )
+	,	m_pendingLimit( 0 )
+	,	m_urgentLevel( c_defaultUrgentLevel )
+	,	m_isChangesOnly( false )
+	,	m_captureTimer( 0 )
+	,	m_isFlushScheduled( false )
+{
+}
+
+SourcesCoalescer::~SourcesCoalescer()
+{
+}
+
+int
+SourcesCoalescer::takeMessagesCount()
+{
+	return m_messagesCount.fetchAndStoreRelaxed( 0 );
+}
+
+int
+SourcesCoalescer::takeDeregistrationsCount()
+{
+	return m_deregistrationsCount.fetchAndStoreRelaxed( 0 );
+}
+
+int
+SourcesCoalescer::takeCoalescedCount()
+{
+	return m_coalescedCount.fetchAndStoreRelaxed( 0 );
+}
+
+int
+SourcesCoalescer::takeDroppedCount()
+{
+	return m_droppedCount.fetchAndStoreRelaxed( 0 );
+}
+
+int
+SourcesCoalescer::takeFilteredCount()
+{
+	return m_filteredCount.fetchAndStoreRelaxed( 0 );
+}
+
+qint64
+SourcesCoalescer::takeBytesCount()
+{
+	return m_bytesCount.fetchAndStoreRelaxed( 0 );
+}
+
+int
+SourcesCoalescer::pendingCount() const
+{
+	return m_pendingCount.loadRelaxed();
+}
+
+void
+SourcesCoalescer::setTimeout( int msecs )
+{
+	m_timeout = msecs;
+
+	if( m_buffers.contains( c_channelUpdateTimeout ) )
+		restartGroupTimer( c_channelUpdateTimeout );
+}
+
+void
+SourcesCoalescer::setPendingLimit( int limit )
+{
+	m_pendingLimit = limit;
+
+	for( auto it = m_buffers.begin(), last = m_buffers.end();
+		it != last; ++it )
+	{
+		it.value().setLimit( limit );
+
+		if( it.value().isFull() )
+			flushGroup( it.key() );
+	}
+}
+
+void
+SourcesCoalescer::setUrgentLevel( int level )
+{
+	m_urgentLevel = static_cast< Level > ( level );
+}
+
+void
+SourcesCoalescer::setChangesOnly( bool on )
+{
+	m_isChangesOnly = on;
+
+	if( !m_isChangesOnly )
+		m_lastValues.clear();
+}
+
+void
+SourcesCoalescer::setFilter( const QStringList & include,
+	const QStringList & exclude )
+{
+	m_filter = SourcesFilter( include, exclude );
+}
+
+void
+SourcesCoalescer::setCaptureFile( const QString & fileName )
+{
+	m_capture.reset();
+
+	if( !fileName.isEmpty() )
+	{
+		m_capture.reset( new TrafficCaptureWriter( fileName ) );
+
+		if( !m_capture->isOpen() )
+			m_capture.reset();
+	}
+
+	// Buffered events are written even if the traffic stops.
+	if( m_capture )
+	{
+		if( !m_captureTimer )
+		{
+			m_captureTimer = new QTimer( this );
+
+			connect( m_captureTimer, &QTimer::timeout,
+				this, &SourcesCoalescer::flushCapture );
+		}
+
+		m_captureTimer->start( c_captureFlushPeriod );
+	}
+	else if( m_captureTimer )
+		m_captureTimer->stop();
+}
+
+void
+SourcesCoalescer::forgetValues()
+{
+	m_lastValues.clear();
+}
+
+void
+SourcesCoalescer::resetGroups()
+{
+	flush();
+
+	qDeleteAll( m_timers );
+
+	m_timers.clear();
+	m_buffers.clear();
+	m_groups.clear();
+}
+
+void
+SourcesCoalescer::sourceHasUpdatedValue( const Como::Source & source )
+{
+	m_messagesCount.fetchAndAddRelaxed( 1 );
+	m_bytesCount.fetchAndAddRelaxed( approximateSize( source ) );
+
+	if( m_capture )
+		m_capture->write( CapturedUpdate, source );
+
+	if( !m_filter.accept( source ) )
+	{
+		m_filteredCount.fetchAndAddRelaxed( 1 );
+
+		return;
+	}
+
+	if( m_isChangesOnly && isUnchanged( source ) )
+	{
+		m_droppedCount.fetchAndAddRelaxed( 1 );
+
+		return;
+	}
+
+	const int group = groupOf( source );
+
+	if( isUrgent( source ) )
+	{
+		// Pending value is older than this one.
+		if( buffer( group ).remove( source ) )
+			updatePendingCount();
+
+		emit sourcesReady( QVector< Como::Source > () << source,
+			steadyMSecs() );
+
+		return;
+	}
+
+	SourcesBuffer & b = buffer( group );
+
+	if( b.insert( source ) )
+		m_coalescedCount.fetchAndAddRelaxed( 1 );
+
+	updatePendingCount();
+
+	if( b.isFull() )
+		flushGroup( group );
+	else if( groupTimeout( group ) <= 0 && !m_isFlushScheduled )
+	{
+		// Without timeout sources are sent out on the next iteration
+		// of the event loop, i.e. in one batch with all messages
+		// already read from the socket.
+		m_isFlushScheduled = true;
+
+		QMetaObject::invokeMethod( this,
+			&SourcesCoalescer::flushWithoutTimeout,
+			Qt::QueuedConnection );
+	}
+}
+
+void
+SourcesCoalescer::sourceHasDeregistered( const Como::Source & source )
+{
+	m_deregistrationsCount.fetchAndAddRelaxed( 1 );
+	m_bytesCount.fetchAndAddRelaxed( approximateSize( source ) );
+
+	if( m_capture )
+		m_capture->write( CapturedDeregistration, source );
+
+	if( !m_filter.accept( source ) )
+	{
+		m_filteredCount.fetchAndAddRelaxed( 1 );
+
+		return;
+	}
+
+	m_lastValues.remove( SourceKey( source ) );
+
+	const int group = groupOf( source );
+
+	if( groupTimeout( group ) > 0 )
+	{
+		buffer( group ).remove( source );
+
+		updatePendingCount();
+	}
+	else
+		flushGroup( group );
+
+	emit sourceDeregistered( source );
+}
+
+void
+SourcesCoalescer::flush()
+{
+	m_isFlushScheduled = false;
+
+	if( m_capture )
+		m_capture->flush();
+
+	for( auto it = m_buffers.cbegin(), last = m_buffers.cend();
+		it != last; ++it )
+			flushGroup( it.key() );
+}
+
+void
+SourcesCoalescer::flushWithoutTimeout()
+{
+	m_isFlushScheduled = false;
+
+	for( auto it = m_buffers.cbegin(), last = m_buffers.cend();
+		it != last; ++it )
+	{
+		if( groupTimeout( it.key() ) <= 0 )
+			flushGroup( it.key() );
+	}
+}
+
+void
+SourcesCoalescer::flushCapture()
+{
+	if( m_capture )
+		m_capture->flush();
+}
+
+bool
+SourcesCoalescer::isUnchanged( const Como::Source & source )
+{
+	const SourceKey key( source );
+
+	auto it = m_lastValues.find( key );
+
+	if( it != m_lastValues.end() )
+	{
+		if( it.value().value() == source.value() &&
+			it.value().description() == source.description() )
+				return true;
+
+		it.value() = source;
+	}
+	else
+		m_lastValues.insert( key, source );
+
+	return false;
+}
+
+bool
+SourcesCoalescer::isUrgent( const Como::Source & source ) const
+{
+	if( m_urgentLevel == None )
+		return false;
+
+	const Level level = PropertiesManager::instance().evaluateLevel(
+		source, m_channelName );
+
+	return ( level != None && level != Uninitialized &&
+		level <= m_urgentLevel );
+}
+
+int
+SourcesCoalescer::groupOf( const Como::Source & source )
+{
+	const SourceKey key( source );
+
+	auto it = m_groups.constFind( key );
+
+	if( it != m_groups.constEnd() )
+		return it.value();
+
+	const int group = PropertiesManager::instance().updateTimeout(
+		source, m_channelName );
+
+	m_groups.insert( key, group );
+
+	return group;
+}
+
+int
+SourcesCoalescer::groupTimeout( int group ) const
+{
+	return ( group == c_channelUpdateTimeout ? m_timeout : group );
+}
+
+SourcesBuffer &
+SourcesCoalescer::buffer( int group )
+{
+	auto it = m_buffers.find( group );
+
+	if( it == m_buffers.end() )
+	{
+		it = m_buffers.insert( group, SourcesBuffer( m_pendingLimit ) );
+
+		QTimer * timer = new QTimer( this );
+
+		connect( timer, &QTimer::timeout,
+			this, [this, group] () { flushGroup( group ); } );
+
+		m_timers.insert( group, timer );
+
+		restartGroupTimer( group );
+	}
+
+	return it.value();
+}
+
+void
+SourcesCoalescer::restartGroupTimer( int group )
+{
+	QTimer * timer = m_timers.value( group );
+
+	timer->stop();
+
+	const int msecs = groupTimeout( group );
+
+	if( msecs > 0 )
+		timer->start( msecs );
+	else
+		flushGroup( group );
+}
+
+void
+SourcesCoalescer::flushGroup( int group )
+{
+	auto it = m_buffers.find( group );
+
+	if( it != m_buffers.end() && !it.value().isEmpty() )
+	{
+		emit sourcesReady( it.value().takeAll(), steadyMSecs() );
+
+		updatePendingCount();
+	}
+}
+
+void
+SourcesCoalescer::updatePendingCount()
+{
+	int count = 0;
+
+	for( auto it = m_buffers.cbegin(), last = m_buffers.cend();
+		it != last; ++it )
+			count += it.value().size();
+
+	m_pendingCount.storeRelaxed( count );
+}
+
+} /* namespace Globe */
@@ -0,0 +1,207 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__SOURCES_COALESCER_HPP__INCLUDED
+#define GLOBE__SOURCES_COALESCER_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QVector>
+#include <QHash>
+#include <QStringList>
+#include <QAtomicInt>
+#include <QScopedPointer>
+
+// Como include.
+#include <Como/Source>
+
+// Globe include.
+#include <Core/export.hpp>
+#include <Core/condition.hpp>
+#include <Core/sources_buffer.hpp>
+#include <Core/sources_filter.hpp>
+#include <Core/traffic_capture.hpp>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+
+namespace Globe {
+
+//! \return Monotonic time in ms, comparable between threads.
+CORE_EXPORT qint64 steadyMSecs();
+
+//! \return Approximate size of the source's message in bytes.
+CORE_EXPORT qint64 approximateSize( const Como::Source & source );
+
+
+//
+// SourcesCoalescer
+//
+
+/*!
+	Coalesces updates of the sources in the thread of the channel's
+	I/O. Only the latest value of each source crosses to the channel's
+	thread, once per timeout.
+
+	Sources with own update timeout in their properties are coalesced
+	in separate groups, one group per timeout, each flushed on it's own
+	schedule. Update evaluated to the urgent level or above is sent
+	out at once. In "changes only" mode update with the same value and
+	description as the previous one of the source is dropped.
+
+	Messages of the sources rejected by the filter are dropped first
+	of all. Before that they are appended to the traffic capture if
+	it's on.
+*/
+class CORE_EXPORT SourcesCoalescer
+	:	public QObject
+{
+	Q_OBJECT
+
+signals:
+	//! Pending sources are ready. \a flushedAt is time of the steadyMSecs().
+	void sourcesReady( const QVector< Como::Source > & sources,
+		qint64 flushedAt );
+	//! Source deregistered.
+	void sourceDeregistered( const Como::Source & source );
+
+public:
+	SourcesCoalescer( const QString & channelName, QObject * parent = 0 );
+
+	~SourcesCoalescer();
+
+	//! \return Count of received updates since last call. Thread-safe.
+	int takeMessagesCount();
+	//! \return Count of received deregistrations since last call. Thread-safe.
+	int takeDeregistrationsCount();
+	//! \return Count of coalesced updates since last call. Thread-safe.
+	int takeCoalescedCount();
+	//! \return Count of dropped unchanged updates since last call. Thread-safe.
+	int takeDroppedCount();
+	//! \return Count of filtered messages since last call. Thread-safe.
+	int takeFilteredCount();
+	//! \return Approximate count of received bytes since last call. Thread-safe.
+	qint64 takeBytesCount();
+	//! \return Count of pending sources. Thread-safe.
+	int pendingCount() const;
+
+public slots:
+	//! Set timeout.
+	void setTimeout( int msecs );
+	//! Set limit of the pending sources.
+	void setPendingLimit( int limit );
+	//! Set level from which updates are sent out at once.
+	void setUrgentLevel( int level );
+	//! Set whether only changed values are sent out.
+	void setChangesOnly( bool on );
+	//! Set filter of the sources.
+	void setFilter( const QStringList & include, const QStringList & exclude );
+	//! Set file of the traffic capture, empty turns capture off.
+	void setCaptureFile( const QString & fileName );
+	//! Forget last values of the sources, i.e. on disconnection.
+	void forgetValues();
+	//! Properties changed, so groups of the sources should be evaluated again.
+	void resetGroups();
+	//! Como::Source has updated his value.
+	void sourceHasUpdatedValue( const Como::Source & source );
+	//! Como::Source has deregistered.
+	void sourceHasDeregistered( const Como::Source & source );
+	//! Send out pending sources of all groups.
+	void flush();
+
+private slots:
+	//! Send out pending sources of the groups without timeout.
+	void flushWithoutTimeout();
+	//! Write buffered events of the traffic capture.
+	void flushCapture();
+
+private:
+	/*!
+		\return Are value and description of the source the same
+		as in the previous update? Remembers them otherwise.
+	*/
+	bool isUnchanged( const Como::Source & source );
+	//! \return Is update of the source urgent?
+	bool isUrgent( const Como::Source & source ) const;
+	//! \return Group (timeout from properties) of the source.
+	int groupOf( const Como::Source & source );
+	//! \return Timeout of the group in ms.
+	int groupTimeout( int group ) const;
+	//! \return Buffer of the group, created if there is no one.
+	SourcesBuffer & buffer( int group );
+	//! (Re)start timer of the group.
+	void restartGroupTimer( int group );
+	//! Send out pending sources of the group.
+	void flushGroup( int group );
+	//! Update count of pending sources.
+	void updatePendingCount();
+
+private:
+	Q_DISABLE_COPY( SourcesCoalescer )
+
+	//! Name of the channel.
+	QString m_channelName;
+	//! Channel's timeout in ms.
+	int m_timeout;
+	//! Limit of the pending sources in each group.
+	int m_pendingLimit;
+	//! Level from which updates are sent out at once.
+	Level m_urgentLevel;
+	//! Are only changed values sent out?
+	bool m_isChangesOnly;
+	//! Filter of the sources.
+	SourcesFilter m_filter;
+	//! Traffic capture.
+	QScopedPointer< TrafficCaptureWriter > m_capture;
+	//! Timer of the traffic capture's flushes.
+	QTimer * m_captureTimer;
+	//! Last values of the sources in "changes only" mode.
+	QHash< SourceKey, Como::Source > m_lastValues;
+	//! Group of the source.
+	QHash< SourceKey, int > m_groups;
+	//! Pending sources of the groups.
+	QHash< int, SourcesBuffer > m_buffers;
+	//! Timers of the groups.
+	QHash< int, QTimer* > m_timers;
+	//! Is flush scheduled for the next loop iteration?
+	bool m_isFlushScheduled;
+	//! Count of received updates.
+	QAtomicInt m_messagesCount;
+	//! Count of received deregistrations.
+	QAtomicInt m_deregistrationsCount;
+	//! Count of coalesced updates.
+	QAtomicInt m_coalescedCount;
+	//! Count of dropped unchanged updates.
+	QAtomicInt m_droppedCount;
+	//! Count of filtered messages.
+	QAtomicInt m_filteredCount;
+	//! Count of pending sources.
+	QAtomicInt m_pendingCount;
+	//! Approximate count of received bytes.
+	QAtomicInteger< qint64 > m_bytesCount;
+}; // class SourcesCoalescer
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_COALESCER_HPP__INCLUDED
@@ -0,0 +1,180 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/sources_filter.hpp>
+
+
+namespace Globe {
+
+//
+// SourcesMatcher
+//
+
+SourcesMatcher::SourcesMatcher()
+	:	m_hasGlobs( false )
+{
+}
+
+//! \return Is there any wildcard in the pattern?
+static inline bool hasWildcards( const QString & pattern )
+{
+	return ( pattern.contains( QLatin1Char( '*' ) ) ||
+		pattern.contains( QLatin1Char( '?' ) ) ||
+		pattern.contains( QLatin1Char( '[' ) ) );
+}
+
+SourcesMatcher::SourcesMatcher( const QStringList & patterns )
+	:	m_hasGlobs( false )
+{
+	QStringList globs;
+
+	for( const QString & p : patterns )
+	{
+		if( p.isEmpty() )
+			continue;
+
+		if( !hasWildcards( p ) )
+			m_exact.insert( p );
+		else if( p.endsWith( QLatin1Char( '*' ) ) &&
+			!hasWildcards( p.left( p.size() - 1 ) ) )
+				m_prefixes.append( p.left( p.size() - 1 ) );
+		else
+			globs.append( QRegularExpression::wildcardToRegularExpression( p,
+				QRegularExpression::NonPathWildcardConversion ) );
+	}
+
+	if( !globs.isEmpty() )
+	{
+		m_globs.setPattern( QStringLiteral( "(?:" ) +
+			globs.join( QStringLiteral( ")|(?:" ) ) + QStringLiteral( ")" ) );
+		m_globs.optimize();
+
+		m_hasGlobs = m_globs.isValid();
+	}
+}
+
+bool
+SourcesMatcher::isEmpty() const
+{
+	return ( m_exact.isEmpty() && m_prefixes.isEmpty() && !m_hasGlobs );
+}
+
+bool
+SourcesMatcher::match( const QString & str ) const
+{
+	if( m_exact.contains( str ) )
+		return true;
+
+	for( const QString & p : m_prefixes )
+	{
+		if( str.startsWith( p ) )
+			return true;
+	}
+
+	if( m_hasGlobs )
+		return m_globs.match( str ).hasMatch();
+
+	return false;
+}
+
+
+//
+// SourcesFilter
+//
+
+SourcesFilter::SourcesFilter()
+{
+}
+
+//! Split patterns to the ones for the names and for the type names.
+static inline void splitPatterns( const QStringList & patterns,
+	QStringList & names, QStringList & types )
+{
+	for( const QString & p : patterns )
+	{
+		if( p.startsWith( c_typeFilterPrefix ) )
+			types.append( p.mid( c_typeFilterPrefix.size() ) );
+		else
+			names.append( p );
+	}
+}
+
+SourcesFilter::SourcesFilter( const QStringList & include,
+	const QStringList & exclude )
+	:	m_include( include )
+	,	m_exclude( exclude )
+{
+	QStringList names, types;
+
+	splitPatterns( m_include, names, types );
+
+	m_includeNames = SourcesMatcher( names );
+	m_includeTypes = SourcesMatcher( types );
+
+	names.clear();
+	types.clear();
+
+	splitPatterns( m_exclude, names, types );
+
+	m_excludeNames = SourcesMatcher( names );
+	m_excludeTypes = SourcesMatcher( types );
+}
+
+const QStringList &
+SourcesFilter::include() const
+{
+	return m_include;
+}
+
+const QStringList &
+SourcesFilter::exclude() const
+{
+	return m_exclude;
+}
+
+bool
+SourcesFilter::isEmpty() const
+{
+	return ( m_includeNames.isEmpty() && m_includeTypes.isEmpty() &&
+		m_excludeNames.isEmpty() && m_excludeTypes.isEmpty() );
+}
+
+bool
+SourcesFilter::match( const SourcesMatcher & names,
+	const SourcesMatcher & types, const Como::Source & source )
+{
+	return ( names.match( source.name() ) ||
+		types.match( source.typeName() ) );
+}
+
+bool
+SourcesFilter::accept( const Como::Source & source ) const
+{
+	if( ( !m_includeNames.isEmpty() || !m_includeTypes.isEmpty() ) &&
+		!match( m_includeNames, m_includeTypes, source ) )
+			return false;
+
+	return !match( m_excludeNames, m_excludeTypes, source );
+}
+
+} /* namespace Globe */
@@ -0,0 +1,128 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__SOURCES_FILTER_HPP__INCLUDED
+#define GLOBE__SOURCES_FILTER_HPP__INCLUDED
+
+// Qt include.
+#include <QStringList>
+#include <QSet>
+#include <QRegularExpression>
+
+// Como include.
+#include <Como/Source>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//! Prefix of the filter's pattern that is applied to the type name.
+static const QString c_typeFilterPrefix = QStringLiteral( "type:" );
+
+
+//
+// SourcesMatcher
+//
+
+/*!
+	Compiled set of patterns. Pattern without wildcards is matched
+	exactly, pattern with the only trailing '*' is matched as prefix,
+	other patterns are globs ('*', '?' and '[...]').
+*/
+class CORE_EXPORT SourcesMatcher {
+public:
+	SourcesMatcher();
+
+	explicit SourcesMatcher( const QStringList & patterns );
+
+	//! \return Is there no one pattern?
+	bool isEmpty() const;
+
+	//! \return Does any pattern match the \a str?
+	bool match( const QString & str ) const;
+
+private:
+	//! Exact patterns.
+	QSet< QString > m_exact;
+	//! Prefixes.
+	QStringList m_prefixes;
+	//! All globs joined into one expression.
+	QRegularExpression m_globs;
+	//! Is there any glob?
+	bool m_hasGlobs;
+}; // class SourcesMatcher
+
+
+//
+// SourcesFilter
+//
+
+/*!
+	Include/exclude filter of the sources in the channel.
+
+	Patterns are applied to the name of the source, patterns
+	prefixed with c_typeFilterPrefix are applied to the type name.
+	Source passes if it matches any include pattern (or there are no
+	include patterns at all) and doesn't match any exclude pattern.
+*/
+class CORE_EXPORT SourcesFilter {
+public:
+	SourcesFilter();
+
+	SourcesFilter( const QStringList & include, const QStringList & exclude );
+
+	//! \return Include patterns.
+	const QStringList & include() const;
+	//! \return Exclude patterns.
+	const QStringList & exclude() const;
+
+	//! \return Does filter pass all sources?
+	bool isEmpty() const;
+
+	//! \return Does the source pass the filter?
+	bool accept( const Como::Source & source ) const;
+
+private:
+	//! \return Does source match the name and type matchers?
+	static bool match( const SourcesMatcher & names,
+		const SourcesMatcher & types, const Como::Source & source );
+
+private:
+	//! Include patterns.
+	QStringList m_include;
+	//! Exclude patterns.
+	QStringList m_exclude;
+	//! Include patterns for the names.
+	SourcesMatcher m_includeNames;
+	//! Include patterns for the type names.
+	SourcesMatcher m_includeTypes;
+	//! Exclude patterns for the names.
+	SourcesMatcher m_excludeNames;
+	//! Exclude patterns for the type names.
+	SourcesMatcher m_excludeTypes;
+}; // class SourcesFilter
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_FILTER_HPP__INCLUDED
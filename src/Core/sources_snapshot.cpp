@@ -0,0 +1,303 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/sources_snapshot.hpp>
+#include <Core/sources.hpp>
+#include <Core/source_codec.hpp>
+#include <Core/log.hpp>
+
+// Qt include.
+#include <QFile>
+#include <QSaveFile>
+#include <QTimer>
+#include <QThreadPool>
+#include <QCoreApplication>
+
+
+namespace Globe {
+
+//! Magic of the snapshot file.
+static const char c_snapshotMagic[] = "GLOBESNP";
+//! Size of the magic.
+static const int c_snapshotMagicSize = 8;
+//! Version of the snapshot file.
+static const quint32 c_snapshotVersion = 1;
+//! Size of the header.
+static const int c_snapshotHeaderSize = c_snapshotMagicSize + 4;
+
+
+//
+// SourcesSnapshotPrivate
+//
+
+class SourcesSnapshotPrivate {
+public:
+	SourcesSnapshotPrivate()
+	{
+		// Snapshots are written one by one in the order of collecting.
+		m_pool.setMaxThreadCount( 1 );
+	}
+
+	//! \return Uncompressed records of all sources.
+	static QByteArray collect()
+	{
+		const SourcesManager & manager = SourcesManager::instance();
+
+		QByteArray data;
+
+		const QList< QString > channels = manager.channelsNames();
+
+		for( const auto & channelName : channels )
+		{
+			const int count = manager.registeredSourcesCount( channelName ) +
+				manager.deregisteredSourcesCount( channelName );
+
+			putString( data, channelName );
+			put< quint32 > ( data, static_cast< quint32 > ( count ) );
+
+			manager.forEachSource( channelName,
+				[&data] ( SourceId, const Como::Source & source,
+					bool isRegistered )
+				{
+					put< quint8 > ( data, isRegistered ? 1 : 0 );
+					putSource( data, source );
+				} );
+		}
+
+		return data;
+	}
+
+	/*!
+		Compress records and write them to the file. Thread-safe.
+
+		\return Error string, empty on success.
+	*/
+	static QString store( const QString & fileName, const QByteArray & data )
+	{
+		QByteArray header( c_snapshotMagic, c_snapshotMagicSize );
+		put< quint32 > ( header, c_snapshotVersion );
+
+		QSaveFile file( fileName );
+
+		if( file.open( QIODevice::WriteOnly ) )
+		{
+			file.write( header );
+			file.write( qCompress( data ) );
+
+			if( file.commit() )
+				return QString();
+		}
+
+		return QString( "Unable to write sources snapshot \"%1\". %2" )
+			.arg( fileName, file.errorString() );
+	}
+
+	//! File name.
+	QString m_fileName;
+	//! Timer of the periodic writing.
+	QTimer m_timer;
+	//! Thread of the periodic writing.
+	QThreadPool m_pool;
+}; // class SourcesSnapshotPrivate
+
+
+//
+// SourcesSnapshot
+//
+
+SourcesSnapshot::SourcesSnapshot( QObject * parent )
+	:	QObject( parent )
+	,	d( new SourcesSnapshotPrivate )
+{
+	connect( &d->m_timer, &QTimer::timeout,
+		this, &SourcesSnapshot::writeInBackground );
+}
+
+SourcesSnapshot::~SourcesSnapshot()
+{
+	d->m_pool.waitForDone();
+}
+
+static SourcesSnapshot * sourcesSnapshotInstancePointer = 0;
+
+void
+SourcesSnapshot::cleanup()
+{
+	delete sourcesSnapshotInstancePointer;
+
+	sourcesSnapshotInstancePointer = 0;
+}
+
+SourcesSnapshot &
+SourcesSnapshot::instance()
+{
+	if( !sourcesSnapshotInstancePointer )
+	{
+		sourcesSnapshotInstancePointer = new SourcesSnapshot;
+
+		qAddPostRoutine( &SourcesSnapshot::cleanup );
+	}
+
+	return *sourcesSnapshotInstancePointer;
+}
+
+const QString &
+SourcesSnapshot::fileName() const
+{
+	return d->m_fileName;
+}
+
+void
+SourcesSnapshot::setFileName( const QString & fileName, int interval )
+{
+	d->m_fileName = fileName;
+
+	if( !d->m_fileName.isEmpty() && interval > 0 )
+		d->m_timer.start( interval * 1000 );
+	else
+		d->m_timer.stop();
+}
+
+bool
+SourcesSnapshot::read()
+{
+	if( d->m_fileName.isEmpty() )
+		return false;
+
+	QFile file( d->m_fileName );
+
+	// There is no snapshot before the first shutdown.
+	if( !file.open( QIODevice::ReadOnly ) )
+		return false;
+
+	const QByteArray header = file.read( c_snapshotHeaderSize );
+
+	if( header.size() != c_snapshotHeaderSize ||
+		!header.startsWith( QByteArray( c_snapshotMagic,
+			c_snapshotMagicSize ) ) ||
+		qFromLittleEndian< quint32 > ( header.constData() +
+			c_snapshotMagicSize ) != c_snapshotVersion )
+	{
+		Log::instance().writeMsgToEventLog( LogLevelWarning,
+			QString( "Sources snapshot \"%1\" has unknown format "
+				"and is ignored." ).arg( d->m_fileName ) );
+
+		return false;
+	}
+
+	const QByteArray data = qUncompress( file.readAll() );
+
+	SourceCursor c( reinterpret_cast< const uchar* > ( data.constData() ),
+		data.size() );
+
+	SourcesManager & manager = SourcesManager::instance();
+
+	int count = 0;
+
+	while( !c.atEnd() )
+	{
+		const QString channelName = c.getString();
+		const quint32 sources = c.get< quint32 > ();
+
+		for( quint32 i = 0; i < sources && c.isOk(); ++i )
+		{
+			const bool isRegistered = ( c.get< quint8 > () != 0 );
+
+			Como::Source source;
+
+			if( c.getSource( source ) )
+			{
+				manager.restoreSource( channelName, source, isRegistered );
+
+				++count;
+			}
+		}
+
+		if( !c.isOk() )
+		{
+			Log::instance().writeMsgToEventLog( LogLevelWarning,
+				QString( "Sources snapshot \"%1\" is corrupted, "
+					"%2 sources restored." )
+						.arg( d->m_fileName, QString::number( count ) ) );
+
+			return false;
+		}
+	}
+
+	Log::instance().writeMsgToEventLog( LogLevelInfo,
+		QString( "%1 sources restored from the snapshot \"%2\"." )
+			.arg( QString::number( count ), d->m_fileName ) );
+
+	return true;
+}
+
+bool
+SourcesSnapshot::write()
+{
+	if( d->m_fileName.isEmpty() )
+		return false;
+
+	const QByteArray data = SourcesSnapshotPrivate::collect();
+
+	// Older snapshot being written in background shouldn't win.
+	d->m_pool.waitForDone();
+
+	const QString error = SourcesSnapshotPrivate::store( d->m_fileName, data );
+
+	if( error.isEmpty() )
+		return true;
+
+	Log::instance().writeMsgToEventLog( LogLevelError, error );
+
+	return false;
+}
+
+void
+SourcesSnapshot::writeInBackground()
+{
+	if( d->m_fileName.isEmpty() )
+		return;
+
+	// Previous snapshot is still being written, next tick will do.
+	if( d->m_pool.activeThreadCount() > 0 )
+		return;
+
+	const QString fileName = d->m_fileName;
+	const QByteArray data = SourcesSnapshotPrivate::collect();
+
+	d->m_pool.start( [this, fileName, data] ()
+		{
+			const QString error =
+				SourcesSnapshotPrivate::store( fileName, data );
+
+			if( !error.isEmpty() )
+				QMetaObject::invokeMethod( this,
+					[error] ()
+					{
+						Log::instance().writeMsgToEventLog(
+							LogLevelError, error );
+					}, Qt::QueuedConnection );
+		} );
+}
+
+} /* namespace Globe */
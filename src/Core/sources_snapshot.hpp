@@ -0,0 +1,108 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__SOURCES_SNAPSHOT_HPP__INCLUDED
+#define GLOBE__SOURCES_SNAPSHOT_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QScopedPointer>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+class SourcesSnapshotPrivate;
+
+//
+// SourcesSnapshot
+//
+
+/*!
+	Snapshot of the sources manager in the binary file.
+
+	Snapshot keeps last values and registration states of all
+	sources, so views show last known state right after the start
+	instead of waiting for the channels. File starts with the header
+	(magic and version) followed by the compressed records in the
+	encoding of the capture file. Snapshot is written periodically
+	and on shutdown, file is replaced atomically.
+
+	Values are collected in the GUI thread, but periodic snapshot
+	is compressed and written in the background thread, so GUI
+	isn't stalled with many sources.
+*/
+class CORE_EXPORT SourcesSnapshot
+	:	public QObject
+{
+	Q_OBJECT
+
+private:
+	SourcesSnapshot( QObject * parent = 0 );
+
+	~SourcesSnapshot();
+
+	static void cleanup();
+
+public:
+	//! \return Instance.
+	static SourcesSnapshot & instance();
+
+	//! \return File name of the snapshot.
+	const QString & fileName() const;
+
+	/*!
+		Set file name of the snapshot and interval of the periodic
+		writing in seconds.
+
+		Empty file name disables snapshot, 0 interval means writing
+		on shutdown only.
+	*/
+	void setFileName( const QString & fileName, int interval );
+
+	/*!
+		Read snapshot into the sources manager. Restored sources are
+		stale until channels update them.
+
+		\return Was snapshot read?
+	*/
+	bool read();
+
+public slots:
+	//! Write snapshot. \return Was snapshot written?
+	bool write();
+
+private slots:
+	//! Write snapshot in the background thread.
+	void writeInBackground();
+
+private:
+	Q_DISABLE_COPY( SourcesSnapshot )
+
+	QScopedPointer< SourcesSnapshotPrivate > d;
+}; // class SourcesSnapshot
+
+} /* namespace Globe */
+
+#endif // GLOBE__SOURCES_SNAPSHOT_HPP__INCLUDED
@@ -0,0 +1,219 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Globe include.
+#include <Core/traffic_capture.hpp>
+#include <Core/sources_coalescer.hpp>
+#include <Core/source_codec.hpp>
+
+// Qt include.
+#include <QDateTime>
+#include <QtEndian>
+
+
+namespace Globe {
+
+//! Magic of the capture file.
+static const char c_captureMagic[] = "GLOBECAP";
+//! Size of the magic.
+static const int c_captureMagicSize = 8;
+//! Version of the capture file.
+static const quint32 c_captureVersion = 1;
+//! Size of the header.
+static const int c_captureHeaderSize = c_captureMagicSize + 4;
+//! Size of the buffer that is written at once.
+static const int c_captureBufferSize = 256 * 1024;
+
+
+//
+// CapturedEvent
+//
+
+CapturedEvent::CapturedEvent()
+	:	m_type( CapturedUpdate )
+	,	m_receivedAt( 0 )
+{
+}
+
+
+//
+// TrafficCaptureWriter
+//
+
+TrafficCaptureWriter::TrafficCaptureWriter( const QString & fileName )
+	:	m_file( fileName )
+	,	m_lastFlush( steadyMSecs() )
+{
+	if( !m_file.open( QIODevice::ReadWrite | QIODevice::Append ) )
+		return;
+
+	if( m_file.size() == 0 )
+	{
+		QByteArray header( c_captureMagic, c_captureMagicSize );
+		put< quint32 > ( header, c_captureVersion );
+
+		m_file.write( header );
+	}
+	else
+	{
+		m_file.seek( 0 );
+
+		const QByteArray header = m_file.read( c_captureHeaderSize );
+
+		if( header.size() != c_captureHeaderSize ||
+			!header.startsWith( QByteArray( c_captureMagic,
+				c_captureMagicSize ) ) ||
+			qFromLittleEndian< quint32 > ( header.constData() +
+				c_captureMagicSize ) != c_captureVersion )
+		{
+			m_file.close();
+
+			return;
+		}
+	}
+
+	m_buffer.reserve( c_captureBufferSize + 1024 );
+}
+
+TrafficCaptureWriter::~TrafficCaptureWriter()
+{
+	flush();
+}
+
+bool
+TrafficCaptureWriter::isOpen() const
+{
+	return m_file.isOpen();
+}
+
+void
+TrafficCaptureWriter::write( CapturedEventType type,
+	const Como::Source & source )
+{
+	if( !m_file.isOpen() )
+		return;
+
+	const int start = m_buffer.size();
+
+	// Size of the record is set below.
+	put< quint32 > ( m_buffer, 0 );
+	put< quint8 > ( m_buffer, static_cast< quint8 > ( type ) );
+	put< qint64 > ( m_buffer, QDateTime::currentMSecsSinceEpoch() );
+	putSource( m_buffer, source );
+
+	qToLittleEndian< quint32 > ( m_buffer.size() - start - 4,
+		m_buffer.data() + start );
+
+	if( m_buffer.size() >= c_captureBufferSize ||
+		steadyMSecs() - m_lastFlush >= c_captureFlushPeriod )
+			flush();
+}
+
+void
+TrafficCaptureWriter::flush()
+{
+	m_lastFlush = steadyMSecs();
+
+	if( m_buffer.isEmpty() || !m_file.isOpen() )
+		return;
+
+	m_file.write( m_buffer );
+	m_file.flush();
+
+	m_buffer.clear();
+}
+
+
+//
+// TrafficCaptureReader
+//
+
+TrafficCaptureReader::TrafficCaptureReader( const QString & fileName )
+	:	m_file( fileName )
+	,	m_data( 0 )
+	,	m_size( 0 )
+	,	m_pos( c_captureHeaderSize )
+{
+	if( !m_file.open( QIODevice::ReadOnly ) )
+		return;
+
+	m_size = m_file.size();
+
+	if( m_size < c_captureHeaderSize )
+		return;
+
+	m_data = m_file.map( 0, m_size );
+
+	if( m_data && ( qstrncmp( reinterpret_cast< const char* > ( m_data ),
+			c_captureMagic, c_captureMagicSize ) != 0 ||
+		qFromLittleEndian< quint32 > ( m_data + c_captureMagicSize ) !=
+			c_captureVersion ) )
+	{
+		m_file.unmap( const_cast< uchar* > ( m_data ) );
+
+		m_data = 0;
+	}
+}
+
+TrafficCaptureReader::~TrafficCaptureReader()
+{
+	if( m_data )
+		m_file.unmap( const_cast< uchar* > ( m_data ) );
+}
+
+bool
+TrafficCaptureReader::isOpen() const
+{
+	return ( m_data != 0 );
+}
+
+bool
+TrafficCaptureReader::next( CapturedEvent & event )
+{
+	if( !m_data || m_size - m_pos < 4 )
+		return false;
+
+	const quint32 size = qFromLittleEndian< quint32 > ( m_data + m_pos );
+
+	if( m_size - m_pos - 4 < size )
+		return false;
+
+	SourceCursor c( m_data + m_pos + 4, size );
+
+	event.m_type = static_cast< CapturedEventType > ( c.get< quint8 > () );
+	event.m_receivedAt = c.get< qint64 > ();
+
+	if( !c.getSource( event.m_source ) )
+		return false;
+
+	m_pos += 4 + size;
+
+	return true;
+}
+
+void
+TrafficCaptureReader::rewind()
+{
+	m_pos = c_captureHeaderSize;
+}
+
+} /* namespace Globe */
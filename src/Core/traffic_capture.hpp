@@ -0,0 +1,153 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GLOBE__TRAFFIC_CAPTURE_HPP__INCLUDED
+#define GLOBE__TRAFFIC_CAPTURE_HPP__INCLUDED
+
+// Qt include.
+#include <QFile>
+#include <QByteArray>
+
+// Como include.
+#include <Como/Source>
+
+// Globe include.
+#include <Core/export.hpp>
+
+
+namespace Globe {
+
+//! Max age of the buffered records of the traffic capture in ms.
+static const int c_captureFlushPeriod = 1000;
+
+
+//
+// CapturedEventType
+//
+
+//! Type of the captured event.
+enum CapturedEventType {
+	//! Source has updated his value.
+	CapturedUpdate = 0,
+	//! Source has deregistered.
+	CapturedDeregistration = 1
+}; // enum CapturedEventType
+
+
+//
+// CapturedEvent
+//
+
+//! Event read from the capture file.
+struct CORE_EXPORT CapturedEvent {
+	CapturedEvent();
+
+	//! Type of the event.
+	CapturedEventType m_type;
+	//! Time of receiving, ms since epoch.
+	qint64 m_receivedAt;
+	//! Source.
+	Como::Source m_source;
+}; // struct CapturedEvent
+
+
+//
+// TrafficCaptureWriter
+//
+
+/*!
+	Appends received events to the capture file.
+
+	File starts with the header (magic and version) followed by
+	records, each one is prefixed with it's size. All numbers are
+	little-endian, strings are UTF-8 prefixed with the size. Records
+	are accumulated in the memory and written with one call when
+	buffer is large enough or a second passed since last write, so
+	capture may stay enabled on heavy traffic.
+*/
+class CORE_EXPORT TrafficCaptureWriter {
+public:
+	explicit TrafficCaptureWriter( const QString & fileName );
+
+	~TrafficCaptureWriter();
+
+	//! \return Is file opened? File with foreign header is not opened.
+	bool isOpen() const;
+
+	//! Append event.
+	void write( CapturedEventType type, const Como::Source & source );
+
+	//! Write buffered events to the file.
+	void flush();
+
+private:
+	Q_DISABLE_COPY( TrafficCaptureWriter )
+
+	//! File.
+	QFile m_file;
+	//! Buffered records.
+	QByteArray m_buffer;
+	//! Time of the last write to the file, steadyMSecs().
+	qint64 m_lastFlush;
+}; // class TrafficCaptureWriter
+
+
+//
+// TrafficCaptureReader
+//
+
+/*!
+	Reads capture file mapped to the memory, so file of any size is
+	read without loading into the memory. Truncated last record,
+	i.e. of the capture that is written right now, is ignored.
+*/
+class CORE_EXPORT TrafficCaptureReader {
+public:
+	explicit TrafficCaptureReader( const QString & fileName );
+
+	~TrafficCaptureReader();
+
+	//! \return Is file opened and mapped?
+	bool isOpen() const;
+
+	//! Read next event. \return false at the end of the file.
+	bool next( CapturedEvent & event );
+
+	//! Start reading from the first event.
+	void rewind();
+
+private:
+	Q_DISABLE_COPY( TrafficCaptureReader )
+
+	//! File.
+	QFile m_file;
+	//! Mapped file.
+	const uchar * m_data;
+	//! Size of the file.
+	qint64 m_size;
+	//! Position of the next record.
+	qint64 m_pos;
+}; // class TrafficCaptureReader
+
+} /* namespace Globe */
+
+#endif // GLOBE__TRAFFIC_CAPTURE_HPP__INCLUDED
@@ -31,6 +31,7 @@
 #include <Core/properties_manager.hpp>
 #include <Core/color_for_level.hpp>
 #include <Core/sources.hpp>
+#include <Core/source_id.hpp>
 #include <Core/mainwindow.hpp>
 #include <Core/channels.hpp>
 
@@ -84,12 +85,15 @@ private:
 //! Additional properties of the source.
 struct SourceProps {
 	SourceProps()
-		:	m_registered( false )
+		:	m_id( c_invalidSourceId )
+		,	m_registered( false )
 		,	m_level( Uninitialized )
 		,	m_connected( false )
 	{
 	}
 
+	//! Identifier of the source.
+	SourceId m_id;
 	//! Registered?
 	bool m_registered;
 	//! Level.
@@ -114,17 +118,42 @@ public:
 		:	SelectablePrivate( selection, scene )
 		,	m_fillColor( ColorForLevel::instance().disconnectedColor() )
 		,	m_level( Uninitialized )
+		,	m_currentId( c_invalidSourceId )
 		,	q( parent )
 	{
 	}
 
 	~AggregatePrivate()
 	{
+		unpinSources();
 	}
 
 	//! Calculate current value.
 	void calcCurrentValue();
 
+	//! Unpin identifiers of the sources.
+	void unpinSources()
+	{
+		for( const auto & channel : qAsConst( m_sources ) )
+		{
+			for( const auto & s : channel )
+				SourceIds::instance().unpin( s.second.m_id );
+		}
+	}
+
+	/*!
+		\return Current value of the source from the sources manager,
+		or the source from the configuration if manager doesn't know it.
+	*/
+	static const Como::Source & value(
+		const QPair< Como::Source, SourceProps > & s )
+	{
+		const Como::Source * current =
+			SourcesManager::instance().findSource( s.second.m_id );
+
+		return ( current ? *current : s.first );
+	}
+
 	//! Sources.
 	QMap< QString, QMap< Key, QPair< Como::Source, SourceProps > > > m_sources;
 	//! Configuration.
@@ -133,8 +162,8 @@ public:
 	QColor m_fillColor;
 	//! Level.
 	Level m_level;
-	//! Current source.
-	Como::Source m_current;
+	//! Identifier of the current source.
+	SourceId m_currentId;
 	//! Current channel.
 	QString m_channel;
 	//! Channels.
@@ -159,6 +188,8 @@ AggregatePrivate::calcCurrentValue()
 	bool connected = false;
 	bool disconnected = false;
 
+	const QPair< Como::Source, SourceProps > * current = 0;
+
 	while( it.hasNext() )
 	{
 		it.next();
@@ -178,7 +209,9 @@ AggregatePrivate::calcCurrentValue()
 
 				m_channel = it.key();
 
-				m_current = s.first;
+				m_currentId = s.second.m_id;
+
+				current = &s;
 
 				m_fillColor =
 					ColorForLevel::instance().color( level );
@@ -191,7 +224,7 @@ AggregatePrivate::calcCurrentValue()
 	}
 
 	if( !disconnected && found )
-		q->setToolTip( createToolTip( m_channel, m_current ) );
+		q->setToolTip( createToolTip( m_channel, value( *current ) ) );
 	else if( disconnected )
 	{
 		m_fillColor = ColorForLevel::instance().disconnectedColor();
@@ -253,6 +286,8 @@ Aggregate::setCfg( const SchemeCfg & cfg )
 
 	dd->m_channels.clear();
 
+	dd->unpinSources();
+
 	dd->m_sources.clear();
 
 	const auto s = sources();
@@ -265,8 +300,15 @@ Aggregate::setCfg( const SchemeCfg & cfg )
 		const Key key( p.first.name(), p.first.typeName() );
 
 		if( !dd->m_sources[ p.second ].contains( key ) )
+		{
+			SourceProps props;
+			props.m_id = SourceIds::instance().id( p.second, p.first );
+
+			SourceIds::instance().pin( props.m_id );
+
 			dd->m_sources[ p.second ].insert( key,
-				qMakePair( p.first, SourceProps() ) );
+				qMakePair( p.first, props ) );
+		}
 	}
 
 	setPos( cfg.pos() );
@@ -295,33 +337,51 @@ Aggregate::syncSource( const Como::Source & source,
 {
 	auto * dd = d_ptr();
 
+	if( !dd->m_sources.contains( channel ) ||
+		!dd->m_sources[ channel ].contains(
+			Key( source.name(), source.typeName() ) ) )
+				return;
+
+	const Properties * props = PropertiesManager::instance()
+		.findProperties( source, channel, 0 );
+
+	Level level = None;
+
+	if( props )
+	{
+		level = props->checkConditions( source.value(),
+			source.type() ).level();
+	}
+
+	syncSource( source, channel, isRegistered, level );
+}
+
+void
+Aggregate::syncSource( const Como::Source & source,
+	const QString & channel, bool isRegistered, Level level )
+{
+	auto * dd = d_ptr();
+
 	const Key key( source.name(), source.typeName() );
 
 	if( dd->m_sources.contains( channel ) &&
 		dd->m_sources[ channel ].contains( key ) )
 	{
-		dd->m_sources[ channel ][ key ].first = source;
-
-		dd->m_sources[ channel ][ key ].second.m_registered = isRegistered;
-
-		dd->m_sources[ channel ][ key ].second.m_connected = true;
+		SourceProps & props = dd->m_sources[ channel ][ key ].second;
 
-		const Properties * props = PropertiesManager::instance()
-			.findProperties( source, channel, 0 );
+		// Keep the value if the sources manager doesn't know the source.
+		if( !SourcesManager::instance().findSource( props.m_id ) )
+			dd->m_sources[ channel ][ key ].first = source;
 
-		Level level = None;
+		props.m_registered = isRegistered;
 
-		if( props )
-		{
-			level = props->checkConditions( source.value(),
-				source.type() ).level();
-		}
+		props.m_connected = true;
 
-		dd->m_sources[ channel ][ key ].second.m_level = level;
+		props.m_level = level;
 
 		if( isRegistered && level < dd->m_level )
 		{
-			dd->m_current = source;
+			dd->m_currentId = props.m_id;
 
 			dd->m_channel = channel;
 
@@ -329,11 +389,11 @@ Aggregate::syncSource( const Como::Source & source,
 
 			dd->m_fillColor = ColorForLevel::instance().color( level );
 
-			setToolTip( createToolTip( dd->m_channel, dd->m_current ) );
+			setToolTip( createToolTip( dd->m_channel, source ) );
 
 			update();
 		}
-		else if( source == dd->m_current )
+		else if( props.m_id == dd->m_currentId )
 			dd->calcCurrentValue();
 		else if( dd->m_level == Uninitialized )
 			dd->calcCurrentValue();
@@ -493,16 +553,21 @@ Aggregate::schemeChanged()
 		{
 			sit.next();
 
-			SourcesManager::instance().syncSource( it.key(), sit.value().first,
-				sit.value().second.m_registered );
+			const SourceId id = sit.value().second.m_id;
+
+			if( SourcesManager::instance().findSource( id ) )
+				sit.value().second.m_registered =
+					SourcesManager::instance().isRegistered( id );
+
+			const Como::Source & source = dd->value( sit.value() );
 
 			const Properties * props = PropertiesManager::instance()
-				.findProperties( sit.value().first, it.key(), 0 );
+				.findProperties( id, source, it.key() );
 
 			if( props )
 			{
-				sit.value().second.m_level = props->checkConditions( sit.value().first.value(),
-					sit.value().first.type() ).level();
+				sit.value().second.m_level = props->checkConditions( source.value(),
+					source.type() ).level();
 			}
 
 			auto * ch = ChannelsManager::instance().channelByName( it.key() );
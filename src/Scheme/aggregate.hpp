@@ -27,6 +27,8 @@
 #include <Scheme/base_item.hpp>
 #include <Scheme/scheme_cfg.hpp>
 
+#include <Core/condition.hpp>
+
 // Como include.
 #include <Como/Source>
 
@@ -77,6 +79,9 @@ public:
 	//! Sync source.
 	void syncSource( const Como::Source & source,
 		const QString & channel, bool isRegistered );
+	//! Sync source with already evaluated level.
+	void syncSource( const Como::Source & source,
+		const QString & channel, bool isRegistered, Level level );
 
 	//! Paint item.
 	void paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
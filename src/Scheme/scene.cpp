@@ -34,6 +34,7 @@
 #include <Core/log.hpp>
 #include <Core/channels.hpp>
 #include <Core/sources.hpp>
+#include <Core/source_id.hpp>
 #include <Core/properties_manager.hpp>
 
 // Qt include.
@@ -46,6 +47,7 @@
 #include <QKeyEvent>
 #include <QMap>
 #include <QList>
+#include <QSet>
 
 // cfgfile include.
 #include <cfgfile/all.hpp>
@@ -88,16 +90,15 @@ public:
 class Key {
 public:
 	Key( const Como::Source & source, const QString & channelName )
-		:	m_source( source )
-		,	m_channelName( channelName )
-		,	m_key( m_channelName + m_source.typeName() + m_source.name() )
+		:	m_channelName( channelName )
+		,	m_key( SourceIds::instance().id( channelName, source ) )
 	{
 	}
 
-	//! \return Source.
-	const Como::Source & source() const
+	Key( const QString & channelName, SourceId id )
+		:	m_channelName( channelName )
+		,	m_key( id )
 	{
-		return m_source;
 	}
 
 	//! \return Channel name.
@@ -106,8 +107,8 @@ public:
 		return m_channelName;
 	}
 
-	//! \return String key.
-	const QString & key() const
+	//! \return Identifier of the source.
+	SourceId key() const
 	{
 		return m_key;
 	}
@@ -118,12 +119,10 @@ public:
 	}
 
 private:
-	//! Source.
-	Como::Source m_source;
 	//! Channel name.
 	QString m_channelName;
-	//! String key.
-	QString m_key;
+	//! Identifier of the source.
+	SourceId m_key;
 }; // class Key
 
 
@@ -137,6 +136,9 @@ public:
 		:	m_mode( ViewScene )
 		,	m_editMode( EditSceneSelect )
 		,	m_parentWidget( 0 )
+		,	m_fullSyncNeeded( true )
+		,	m_syncedVersion( 0 )
+		,	m_syncedEpoch( 0 )
 	{
 	}
 
@@ -228,6 +230,20 @@ public:
 			a->syncSource( s, channel, true );
 	}
 
+	//! Update source with already evaluated level.
+	void updateSource( const EvaluatedSource & s, const QString & channel )
+	{
+		const Key key( channel, s.id() );
+
+		QMap< Key, Source* >::Iterator it = m_sources.find( key );
+
+		if( it != m_sources.end() )
+			it.value()->setSource( s.source(), s.level() );
+
+		for( Aggregate * a : qAsConst( m_agg ) )
+			a->syncSource( s.source(), channel, true, s.level() );
+	}
+
 	//! Mode of the scene.
 	SceneMode m_mode;
 	//! Edit mode of the scene.
@@ -236,6 +252,8 @@ public:
 	QWidget * m_parentWidget;
 	//! Source items.
 	QMap< Key, Source* > m_sources;
+	//! Channels in use.
+	QSet< QString > m_channels;
 	//! Selection.
 	Selection m_selection;
 	//! Text items.
@@ -246,6 +264,12 @@ public:
 	QString m_cfgFile;
 	//! Name of the scheme.
 	QString m_name;
+	//! Should all sources be synced on the next sync?
+	bool m_fullSyncNeeded;
+	//! Version of the sources the items are synced with.
+	quint64 m_syncedVersion;
+	//! Epoch of the sources the items are synced with.
+	quint64 m_syncedEpoch;
 }; // class ScenePrivate
 
 
@@ -318,6 +342,14 @@ Scene::setMode( SceneMode mode )
 {
 	d->m_selection.clear();
 
+	// Items were up to date while in view mode, remember the point
+	// to apply only changes made after it on return to view mode.
+	if( d->m_mode == ViewScene && mode != ViewScene )
+	{
+		d->m_syncedVersion = SourcesManager::instance().lastVersion();
+		d->m_syncedEpoch = SourcesManager::instance().epoch();
+	}
+
 	d->m_mode = mode;
 
 	d->notifyItemsAboutModeChange( d->m_mode );
@@ -552,6 +584,8 @@ Scene::initScheme( const SchemeCfg & cfg )
 
 	populateChannels();
 
+	d->m_fullSyncNeeded = true;
+
 	syncSources();
 }
 
@@ -571,6 +605,8 @@ Scene::addSource( const QString & channelName, const Como::Source & source,
 		addChannel( channelName );
 
 	d->m_sources.insert( Key( source, channelName ), item );
+
+	d->m_fullSyncNeeded = true;
 }
 
 void
@@ -716,6 +752,8 @@ Scene::keyPressEvent( QKeyEvent * keyEvent )
 void
 Scene::channelRemoved( Globe::Channel * channel )
 {
+	d->m_channels.remove( channel->name() );
+
 	if( d->m_mode == ViewScene )
 	{
 		d->channelDisconnected( channel->name() );
@@ -723,14 +761,13 @@ Scene::channelRemoved( Globe::Channel * channel )
 }
 
 void
-Scene::sourceUpdated( const Como::Source & source )
+Scene::sourcesEvaluated( const QVector< EvaluatedSource > & sources,
+	const QString & channelName )
 {
-	if( d->m_mode == ViewScene )
+	if( d->m_mode == ViewScene && d->m_channels.contains( channelName ) )
 	{
-		Channel * channel = static_cast< Channel* > ( sender() );
-
-		if( channel )
-			d->updateSource( source, channel->name() );
+		for( const auto & source : sources )
+			d->updateSource( source, channelName );
 	}
 }
 
@@ -746,6 +783,31 @@ Scene::sourceDeregistered( const Como::Source & source )
 	}
 }
 
+void
+Scene::sourcesEvicted( const QVector< Como::Source > & sources,
+	const QString & channelName )
+{
+	// Items keep last values of the evicted sources in any mode,
+	// since they aren't in the sources manager anymore.
+	if( d->m_channels.contains( channelName ) )
+	{
+		for( const auto & source : sources )
+		{
+			QMap< Key, Source* >::Iterator it =
+				d->m_sources.find( Key( source, channelName ) );
+
+			if( it != d->m_sources.end() )
+			{
+				it.value()->setSource( source );
+				it.value()->deregistered();
+			}
+
+			for( Aggregate * a : qAsConst( d->m_agg ) )
+				a->syncSource( source, channelName, false );
+		}
+	}
+}
+
 void
 Scene::connected()
 {
@@ -803,6 +865,12 @@ Scene::init()
 	connect( &SourcesManager::instance(), &SourcesManager::newSource,
 		this, &Scene::newSource );
 
+	connect( &SourcesManager::instance(), &SourcesManager::sourcesEvaluated,
+		this, &Scene::sourcesEvaluated );
+
+	connect( &SourcesManager::instance(), &SourcesManager::sourcesEvicted,
+		this, &Scene::sourcesEvicted );
+
 	connect( &PropertiesManager::instance(),
 		&PropertiesManager::propertiesChanged,
 		this, &Scene::propertiesChanged );
@@ -843,8 +911,7 @@ Scene::addChannel( const QString & name )
 
 	if( channel )
 	{
-		connect( channel, &Channel::sourceUpdated,
-			this, &Scene::sourceUpdated );
+		d->m_channels.insert( name );
 
 		connect( channel, &Channel::sourceDeregistered,
 			this, &Scene::sourceDeregistered );
@@ -874,8 +941,10 @@ Scene::removeChannel( const QString & name )
 {
 	Channel * channel = ChannelsManager::instance().channelByName( name );
 
+	d->m_channels.remove( name );
+
 	if( channel )
-		disconnect( channel, 0, 0, 0 );
+		disconnect( channel, 0, this, 0 );
 }
 
 bool
@@ -903,6 +972,8 @@ Scene::isChannelInUse( const QString & name )
 void
 Scene::syncSources()
 {
+	const SourcesManager & manager = SourcesManager::instance();
+
 	QList< QString > channels;
 
 	{
@@ -914,6 +985,50 @@ Scene::syncSources()
 
 			if( !channels.contains( it.key().channelName() ) )
 				channels.append( it.key().channelName() );
+		}
+	}
+
+	for( const auto * agg : qAsConst( d->m_agg ) )
+	{
+		for( const auto & ch : qAsConst( agg->listOfChannels() ) )
+		{
+			if( !channels.contains( ch ) )
+				channels.append( ch );
+		}
+	}
+
+	if( !d->m_fullSyncNeeded && d->m_syncedEpoch == manager.epoch() )
+	{
+		// Only sources changed since the last sync are applied.
+		for( const auto & ch : qAsConst( channels ) )
+		{
+			manager.forEachChangedSource( ch, d->m_syncedVersion,
+				[this, &ch] ( SourceId id, const Como::Source & s,
+					bool isRegistered )
+				{
+					QMap< Key, Source* >::Iterator it =
+						d->m_sources.find( Key( ch, id ) );
+
+					if( it != d->m_sources.end() )
+					{
+						it.value()->setSource( s );
+
+						if( !isRegistered )
+							it.value()->deregistered();
+					}
+
+					for( auto * agg : qAsConst( d->m_agg ) )
+						agg->syncSource( s, ch, isRegistered );
+				} );
+		}
+	}
+	else
+	{
+		QMapIterator< Key, Source* > it( d->m_sources );
+
+		while( it.hasNext() )
+		{
+			it.next();
 
 			Como::Source s = it.value()->source();
 			bool isRegistered = false;
@@ -925,30 +1040,28 @@ Scene::syncSources()
 			if( !isRegistered )
 				it.value()->deregistered();
 		}
-	}
 
-	for( auto * agg : qAsConst( d->m_agg ) )
-	{
-		for( const auto & ch : qAsConst( agg->listOfChannels() ) )
+		for( auto * agg : qAsConst( d->m_agg ) )
 		{
-			if( !channels.contains( ch ) )
-				channels.append( ch );
-		}
+			const auto s = agg->sources();
 
-		const auto s = agg->sources();
-
-		for( const auto & p : s )
-		{
-			Como::Source tmp = p.first;
-			bool isRegistered = false;
+			for( const auto & p : s )
+			{
+				Como::Source tmp = p.first;
+				bool isRegistered = false;
 
-			SourcesManager::instance().syncSource( p.second,
-				tmp, isRegistered );
+				SourcesManager::instance().syncSource( p.second,
+					tmp, isRegistered );
 
-			agg->syncSource( tmp, p.second, isRegistered );
+				agg->syncSource( tmp, p.second, isRegistered );
+			}
 		}
 	}
 
+	d->m_fullSyncNeeded = false;
+	d->m_syncedVersion = manager.lastVersion();
+	d->m_syncedEpoch = manager.epoch();
+
 	QMap< QString, bool > connectedDisconnected;
 
 	foreach( const QString & name, channels )
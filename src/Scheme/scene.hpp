@@ -24,6 +24,8 @@
 #define GLOBE__SCHEME__SCENE_HPP__INCLUDED
 
 // Globe include.
+#include <Core/export.hpp>
+#include <Core/sources.hpp>
 #include <Scheme/enums.hpp>
 
 // Como include.
@@ -32,6 +34,7 @@
 // Qt include.
 #include <QGraphicsScene>
 #include <QScopedPointer>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 class QWidget;
@@ -58,7 +61,7 @@ class SchemeCfg;
 class ScenePrivate;
 
 //! Scene that will display the scheme.
-class Scene
+class CORE_EXPORT Scene
 	:	public QGraphicsScene
 {
 	Q_OBJECT
@@ -122,10 +125,14 @@ protected:
 private slots:
 	//! Channel was removed.
 	void channelRemoved( Globe::Channel * channel );
-	//! New source or update.
-	void sourceUpdated( const Como::Source & source );
+	//! New sources or updates evaluated.
+	void sourcesEvaluated( const QVector< Globe::EvaluatedSource > & sources,
+		const QString & channelName );
 	//! Source deregistered.
 	void sourceDeregistered( const Como::Source & source );
+	//! Deregistered sources evicted.
+	void sourcesEvicted( const QVector< Como::Source > & sources,
+		const QString & channelName );
 	//! Connected to host.
 	void connected();
 	//! Disconnected from host.
@@ -27,6 +27,8 @@
 
 #include <Core/properties_manager.hpp>
 #include <Core/color_for_level.hpp>
+#include <Core/sources.hpp>
+#include <Core/source_id.hpp>
 
 // Qt include.
 #include <QPainter>
@@ -53,17 +55,30 @@ public:
 		:	SelectablePrivate( selection, scene )
 		,	m_source( source )
 		,	m_channelName( channelName )
+		,	m_id( SourceIds::instance().id( channelName, source ) )
 	{
+		SourceIds::instance().pin( m_id );
 	}
 
 	~SourcePrivate()
 	{
+		SourceIds::instance().unpin( m_id );
 	}
 
-	//! Source.
+	//! \return Current value of the source.
+	const Como::Source & current() const
+	{
+		const Como::Source * s = SourcesManager::instance().findSource( m_id );
+
+		return ( s ? *s : m_source );
+	}
+
+	//! Source, value is used only while sources manager doesn't know it.
 	Como::Source m_source;
 	//! Channel name.
 	QString m_channelName;
+	//! Identifier of the source.
+	SourceId m_id;
 	//! Color for painting.
 	QColor m_fillColor;
 	//! Current properties key.
@@ -104,27 +119,34 @@ Source::channelName() const
 const Como::Source &
 Source::source() const
 {
-	return d_ptr()->m_source;
+	return d_ptr()->current();
 }
 
 void
 Source::setSource( const Como::Source & source )
 {
-	auto * dd = d_ptr();
-
-	dd->m_source = source;
-
 	const Properties * props = PropertiesManager::instance().findProperties(
-		dd->m_source, dd->m_channelName, 0 );
+		source, d_ptr()->m_channelName, 0 );
 
 	Level level = None;
 
 	if( props )
 	{
-		level = props->checkConditions( dd->m_source.value(),
-			dd->m_source.type() ).level();
+		level = props->checkConditions( source.value(),
+			source.type() ).level();
 	}
 
+	setSource( source, level );
+}
+
+void
+Source::setSource( const Como::Source & source, Level level )
+{
+	auto * dd = d_ptr();
+
+	if( !SourcesManager::instance().findSource( dd->m_id ) )
+		dd->m_source = source;
+
 	dd->m_fillColor = ColorForLevel::instance().color( level );
 
 	setToolTip( createToolTip( dd->m_channelName, source ) );
@@ -187,15 +209,17 @@ Source::propertiesChanged()
 {
 	auto * dd = d_ptr();
 
+	const Como::Source & source = dd->current();
+
 	const Properties * props = PropertiesManager::instance().findProperties(
-		dd->m_source, dd->m_channelName, 0 );
+		dd->m_id, source, dd->m_channelName );
 
 	Level level = None;
 
 	if( props )
 	{
-		level = props->checkConditions( dd->m_source.value(),
-			dd->m_source.type() ).level();
+		level = props->checkConditions( source.value(),
+			source.type() ).level();
 	}
 
 	const QColor newColor = ColorForLevel::instance().color( level );
@@ -241,7 +265,7 @@ Source::paint( QPainter * painter, const QStyleOptionGraphicsItem * option,
 	painter->setFont( dd->m_font );
 
 	painter->drawText( boundingRect(), Qt::AlignCenter | Qt::TextWordWrap,
-		dd->m_source.value().toString() );
+		dd->current().value().toString() );
 }
 
 void
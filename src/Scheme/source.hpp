@@ -30,6 +30,8 @@
 #include <Scheme/source_cfg.hpp>
 #include <Scheme/base_item.hpp>
 
+#include <Core/condition.hpp>
+
 
 namespace Globe {
 
@@ -66,6 +68,8 @@ public:
 	const Como::Source & source() const;
 	//! Set source.
 	void setSource( const Como::Source & source );
+	//! Set source with already evaluated level.
+	void setSource( const Como::Source & source, Level level );
 
 	//! \return Configuration.
 	SourceCfg cfg() const;
@@ -21,7 +21,8 @@
 */
 
 // Core include.
-#include <Core/channels.hpp>
+#include <Core/ingest_channel.hpp>
+#include <Core/sources_coalescer.hpp>
 
 // Como include.
 #include <Como/ClientSocket>
@@ -30,6 +31,7 @@
 #include <QThread>
 #include <QTimer>
 #include <QHostAddress>
+#include <QDateTime>
 
 
 namespace Globe {
@@ -38,6 +40,17 @@ namespace Globe {
 // ChannelAndThreadDeleter
 //
 
+//! Timeout of the graceful disconnection on teardown in ms.
+static const int c_disconnectTimeout = 1000;
+
+/*!
+	Asynchronous teardown of the channel's socket.
+
+	Socket is disconnected gracefully (but no longer than
+	c_disconnectTimeout), then it's deleted in it's own thread
+	and only after that the thread is returned to the pool.
+	GUI thread is never blocked.
+*/
 class ChannelAndThreadDeleter
 	:	public QObject
 {
@@ -48,12 +61,16 @@ public:
 		QThread * thread, Como::ClientSocket * socket )
 		:	m_thread( thread )
 		,	m_socket( socket )
+		,	m_isDone( false )
 	{
 		if( isConnected )
 		{
 			connect( m_socket, &Como::ClientSocket::disconnected,
 				this, &ChannelAndThreadDeleter::jobDone );
 
+			QTimer::singleShot( c_disconnectTimeout,
+				this, &ChannelAndThreadDeleter::jobDone );
+
 			QMetaObject::invokeMethod( m_socket, "disconnectFrom",
 				Qt::QueuedConnection );
 		}
@@ -64,12 +81,22 @@ public:
 public slots:
 	void jobDone()
 	{
+		if( m_isDone )
+			return;
+
+		m_isDone = true;
+
 		m_socket->disconnect();
-		m_thread->disconnect();
-		m_thread->quit();
-		m_thread->wait();
+
+		connect( m_socket, &QObject::destroyed,
+			this, &ChannelAndThreadDeleter::socketDestroyed );
+
 		m_socket->deleteLater();
-		m_thread->deleteLater();
+	}
+
+	void socketDestroyed()
+	{
+		ChannelPluginInterface::releaseIOThread( m_thread );
 
 		deleteLater();
 	}
@@ -77,6 +104,7 @@ public slots:
 private:
 	QThread * m_thread;
 	Como::ClientSocket * m_socket;
+	bool m_isDone;
 }; // class ChannelAndThreadDeleter
 
 
@@ -87,13 +115,14 @@ class ComoChannel;
 //
 
 class ComoChannelPrivate
-	:	public ChannelPrivate
+	:	public IngestChannelPrivate
 {
 public:
 	ComoChannelPrivate( ComoChannel * parent,
 		const QString & name,
 		const QString & address,
-		quint16 port );
+		quint16 port,
+		QThread * thread );
 
 	~ComoChannelPrivate();
 
@@ -105,24 +134,12 @@ public:
 	inline const ComoChannel * q_func() const;
 
 
-	//! Thread for the socket.
-	QThread * m_thread;
 	//! Socket implemetation.
 	Como::ClientSocket * m_socket;
-	//! Timer for updating messages rate per second.
-	QTimer * m_rateTimer;
-	//! Update of source's value timeout in ms.
-	int m_updateTimeout;
-	//! Timer for updating source's value.
-	QTimer * m_updateTimer;
-	//! Count of messages in the current second.
-	int m_messagesCount;
-	//! List of sources.
-	QList< Como::Source > m_sources;
-	//! Is channel in connected state?
-	bool m_isConnected;
-	//! Is channel was disconnected by user?
-	bool m_isDisconnectedByUser;
+	//! Timer for reconnection.
+	QTimer * m_reconnectTimer;
+	//! Is reconnection requested by user?
+	bool m_isReconnectRequested;
 }; // class ComoChannelPrivate
 
 
@@ -134,7 +151,7 @@ public:
 	Como channel in the Globe.
 */
 class ComoChannel
-	:	public Channel
+	:	public IngestChannel
 {
 	Q_OBJECT
 
@@ -157,50 +174,41 @@ public:
 		//! Host address.
 		const QString & address,
 		//! Port.
-		quint16 port );
+		quint16 port,
+		//! Thread for the socket.
+		QThread * thread );
 
 	~ComoChannel();
 
-	//! \return Timeout in the channel.
-	int timeout() const;
-	//! \return Is channel in connected state.
-	bool isConnected() const;
-	//! \return Whether the user wants to make this channel connected.
-	bool isMustBeConnected() const;
 	//! \return Type of the channel.
 	const QString & channelType() const;
 
 protected:
-	//! Activate channel.
-	void activate();
-	//! Deactivate channel.
-	void deactivate();
-
 	//! Implementation of the "connect to host" operation.
 	void connectToHostImplementation();
 	//! Implementation of the "Disconnect from host" operation.
 	void disconnectFromHostImplementation();
 	//! Implementation of the "reconnect to host" operation.
 	void reconnectToHostImplementation();
-	//! Implementation of the "update timeout" operation.
-	void updateTimeoutImplementation( int msecs );
+	//! Request list of sources from the host.
+	void requestSources();
 
 private slots:
 	//! Socket implementation has been disconnected.
 	void socketDisconnected();
 	//! Socket implementation has been connected.
 	void socketConnected();
-	//! Como::Source has updated his value.
-	void sourceHasUpdatedValue( const Como::Source & source );
-	//! Como::Source has deregistered.
-	void sourceHasDeregistered( const Como::Source & source );
-	//! Update messages rate timer shots.
-	void updateMessagesRate();
-	//! Update source's values timer shots.
-	void updateSourcesValue();
+	//! Reconnection timer shots.
+	void reconnectTimerFired();
 	//! Socket's error.
 	void socketError( QAbstractSocket::SocketError socketError );
 
+private:
+	//! Schedule reconnection to host if it's not scheduled yet.
+	void scheduleReconnect();
+	//! Cancel scheduled reconnection and reset policy.
+	void cancelReconnect();
+
 private:
 	Q_DISABLE_COPY( ComoChannel )
 
@@ -221,16 +229,12 @@ private:
 ComoChannelPrivate::ComoChannelPrivate( ComoChannel * parent,
 	const QString & name,
 	const QString & address,
-	quint16 port )
-	:	ChannelPrivate( parent, name, address, port )
-	,	m_thread( 0 )
+	quint16 port,
+	QThread * thread )
+	:	IngestChannelPrivate( parent, name, address, port, thread )
 	,	m_socket( 0 )
-	,	m_rateTimer( 0 )
-	,	m_updateTimeout( 0 )
-	,	m_updateTimer( 0 )
-	,	m_messagesCount( 0 )
-	,	m_isConnected( false )
-	,	m_isDisconnectedByUser( true )
+	,	m_reconnectTimer( 0 )
+	,	m_isReconnectRequested( false )
 {}
 
 ComoChannelPrivate::~ComoChannelPrivate()
@@ -244,16 +248,12 @@ ComoChannelPrivate::~ComoChannelPrivate()
 void
 ComoChannelPrivate::init()
 {
-	m_thread = new QThread;
 	m_socket = new Como::ClientSocket;
 
 	ComoChannel * q = q_func();
 
-	m_rateTimer = new QTimer( q );
-	m_updateTimer = new QTimer( q );
-
-	m_socket->moveToThread( m_thread );
-	m_thread->start();
+	m_reconnectTimer = new QTimer( q );
+	m_reconnectTimer->setSingleShot( true );
 }
 
 inline ComoChannel *
@@ -274,13 +274,16 @@ ComoChannelPrivate::q_func() const
 //
 
 ComoChannel::ComoChannel( const QString & name,
-	const QString & address, quint16 port )
-	:	Channel( new ComoChannelPrivate( this, name, address, port ) )
+	const QString & address, quint16 port, QThread * thread )
+	:	IngestChannel( new ComoChannelPrivate( this, name, address, port,
+			thread ) )
 {
 	ComoChannelPrivate * d = d_func();
 
 	d->init();
 
+	initCoalescer( d->m_socket );
+
 	connect( this, &ComoChannel::aboutToConnectToHost,
 		d->m_socket, &Como::ClientSocket::connectTo,
 		Qt::QueuedConnection );
@@ -293,6 +296,21 @@ ComoChannel::ComoChannel( const QString & name,
 		d->m_socket, &Como::ClientSocket::sendGetListOfSourcesMessage,
 		Qt::QueuedConnection );
 
+	// Coalescer lives in the socket's thread, so these connections are
+	// direct. Pending sources are flushed before disconnected() is
+	// delivered to the channel.
+	connect( d->m_socket, &Como::ClientSocket::sourceHasUpdatedValue,
+		d->m_coalescer, &SourcesCoalescer::sourceHasUpdatedValue );
+
+	connect( d->m_socket, &Como::ClientSocket::sourceDeinitialized,
+		d->m_coalescer, &SourcesCoalescer::sourceHasDeregistered );
+
+	connect( d->m_socket, &Como::ClientSocket::disconnected,
+		d->m_coalescer, &SourcesCoalescer::flush );
+
+	connect( d->m_socket, &Como::ClientSocket::disconnected,
+		d->m_coalescer, &SourcesCoalescer::forgetValues );
+
 	connect( d->m_socket, &Como::ClientSocket::connected,
 		this, &ComoChannel::socketConnected,
 		Qt::QueuedConnection );
@@ -301,57 +319,21 @@ ComoChannel::ComoChannel( const QString & name,
 		this, &ComoChannel::socketDisconnected,
 		Qt::QueuedConnection );
 
-	connect( d->m_socket, &Como::ClientSocket::sourceHasUpdatedValue,
-		this, &ComoChannel::sourceHasUpdatedValue,
-		Qt::QueuedConnection );
-
 	connect( d->m_socket, &Como::ClientSocket::errorOccurred,
 		this, &ComoChannel::socketError,
 		Qt::QueuedConnection );
 
-	connect( d->m_socket, &Como::ClientSocket::sourceDeinitialized,
-		this, &ComoChannel::sourceHasDeregistered,
-		Qt::QueuedConnection );
-
-	connect( d->m_rateTimer, &QTimer::timeout,
-		this, &ComoChannel::updateMessagesRate );
-
-	connect( d->m_updateTimer, &QTimer::timeout,
-		this, &ComoChannel::updateSourcesValue );
+	connect( d->m_reconnectTimer, &QTimer::timeout,
+		this, &ComoChannel::reconnectTimerFired );
 
-	d->m_rateTimer->start( 1000 );
+	d->m_socket->moveToThread( d->m_thread );
 }
 
 ComoChannel::~ComoChannel()
 {
 	ComoChannelPrivate * d = d_func();
 
-	d->m_rateTimer->stop();
-	d->m_updateTimer->stop();
-}
-
-int
-ComoChannel::timeout() const
-{
-	const ComoChannelPrivate * d = d_func();
-
-	return d->m_updateTimeout;
-}
-
-bool
-ComoChannel::isConnected() const
-{
-	const ComoChannelPrivate * d = d_func();
-
-	return d->m_isConnected;
-}
-
-bool
-ComoChannel::isMustBeConnected() const
-{
-	const ComoChannelPrivate * d = d_func();
-
-	return !d->m_isDisconnectedByUser;
+	d->m_reconnectTimer->stop();
 }
 
 static const QString c_comoChannelType = QStringLiteral( "como" );
@@ -362,16 +344,6 @@ ComoChannel::channelType() const
 	return c_comoChannelType;
 }
 
-void
-ComoChannel::activate()
-{
-}
-
-void
-ComoChannel::deactivate()
-{
-}
-
 void
 ComoChannel::connectToHostImplementation()
 {
@@ -379,6 +351,8 @@ ComoChannel::connectToHostImplementation()
 
 	d->m_isDisconnectedByUser = false;
 
+	cancelReconnect();
+
 	emit aboutToConnectToHost( QHostAddress( d->m_address ), d->m_port );
 }
 
@@ -389,6 +363,8 @@ ComoChannel::disconnectFromHostImplementation()
 
 	d->m_isDisconnectedByUser = true;
 
+	cancelReconnect();
+
 	emit aboutToDisconnectFromHost();
 }
 
@@ -399,22 +375,22 @@ ComoChannel::reconnectToHostImplementation()
 
 	d->m_isDisconnectedByUser = false;
 
-	emit aboutToDisconnectFromHost();
+	cancelReconnect();
+
+	if( d->m_isConnected )
+	{
+		d->m_isReconnectRequested = true;
+
+		emit aboutToDisconnectFromHost();
+	}
+	else
+		emit aboutToConnectToHost( QHostAddress( d->m_address ), d->m_port );
 }
 
 void
-ComoChannel::updateTimeoutImplementation( int msecs )
+ComoChannel::requestSources()
 {
-	ComoChannelPrivate * d = d_func();
-
-	d->m_updateTimer->stop();
-
-	d->m_updateTimeout = msecs;
-
-	if( d->m_updateTimeout > 0 )
-		d->m_updateTimer->start( d->m_updateTimeout );
-	else
-		updateSourcesValue();
+	emit aboutToSendGetListOfSources();
 }
 
 void
@@ -426,8 +402,14 @@ ComoChannel::socketDisconnected()
 
 	emit disconnected();
 
-	if( !d->m_isDisconnectedByUser )
+	if( d->m_isReconnectRequested )
+	{
+		d->m_isReconnectRequested = false;
+
 		emit aboutToConnectToHost( QHostAddress( d->m_address ), d->m_port );
+	}
+	else if( !d->m_isDisconnectedByUser )
+		scheduleReconnect();
 }
 
 void
@@ -437,6 +419,8 @@ ComoChannel::socketConnected()
 
 	d->m_isConnected = true;
 
+	cancelReconnect();
+
 	emit connected();
 
 	emit aboutToSendGetListOfSources();
@@ -450,69 +434,49 @@ ComoChannel::socketError( QAbstractSocket::SocketError socketError )
 		ComoChannelPrivate * d = d_func();
 
 		if( !d->m_isDisconnectedByUser )
-			emit aboutToConnectToHost( QHostAddress( d->m_address ), d->m_port );
+			scheduleReconnect();
 	}
 }
 
 void
-ComoChannel::sourceHasUpdatedValue( const Como::Source & source )
+ComoChannel::reconnectTimerFired()
 {
 	ComoChannelPrivate * d = d_func();
 
-	++d->m_messagesCount;
-
-	if( d->m_updateTimeout > 0 )
-	{
-		const int index = d->m_sources.indexOf( source );
-
-		if( index != -1 )
-			d->m_sources[ index ] = source;
-		else
-			d->m_sources.push_back( source );
-	}
-	else
-		emit sourceUpdated( source );
+	if( !d->m_isDisconnectedByUser && !d->m_isConnected )
+		emit aboutToConnectToHost( QHostAddress( d->m_address ), d->m_port );
 }
 
 void
-ComoChannel::sourceHasDeregistered( const Como::Source & source )
+ComoChannel::scheduleReconnect()
 {
 	ComoChannelPrivate * d = d_func();
 
-	++d->m_messagesCount;
+	// Connection error and disconnection may both come for one attempt.
+	if( d->m_reconnectTimer->isActive() )
+		return;
 
-	if( d->m_updateTimeout > 0 )
-	{
-		const int index = d->m_sources.indexOf( source );
+	const int delay = d->m_reconnectPolicy.nextDelay();
 
-		if( index != -1 )
-			d->m_sources.removeAt( index );
+	d->m_reconnectTimer->start( delay );
 
-		emit sourceDeregistered( source );
-	}
-	else
-		emit sourceDeregistered( source );
+	emit reconnectStateChanged( d->m_reconnectPolicy.attempt(),
+		QDateTime::currentDateTime().addMSecs( delay ) );
 }
 
 void
-ComoChannel::updateMessagesRate()
+ComoChannel::cancelReconnect()
 {
 	ComoChannelPrivate * d = d_func();
 
-	emit messagesRate( d->m_messagesCount );
+	d->m_reconnectTimer->stop();
 
-	d->m_messagesCount = 0;
-}
-
-void
-ComoChannel::updateSourcesValue()
-{
-	ComoChannelPrivate * d = d_func();
-
-	foreach( const Como::Source & source, d->m_sources )
-		emit sourceUpdated( source );
+	if( d->m_reconnectPolicy.attempt() > 0 )
+	{
+		d->m_reconnectPolicy.reset();
 
-	d->m_sources.clear();
+		emit reconnectStateChanged( 0, QDateTime() );
+	}
 }
 
 
@@ -550,7 +514,8 @@ public:
 		QHostAddress addr( hostAddress );
 
 		if( !addr.isNull() )
-			return ( new ComoChannel( name, hostAddress, port ) );
+			return ( new ComoChannel( name, hostAddress, port,
+				acquireIOThread() ) );
 		else
 			return Q_NULLPTR;
 	}
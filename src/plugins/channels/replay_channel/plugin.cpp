@@ -0,0 +1,941 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Core include.
+#include <Core/ingest_channel.hpp>
+#include <Core/sources_coalescer.hpp>
+#include <Core/configuration.hpp>
+#include <Core/traffic_capture.hpp>
+
+// Qt include.
+#include <QThread>
+#include <QTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDateTime>
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QScopedPointer>
+#include <QAtomicInt>
+
+
+namespace Globe {
+
+//! Format of the date and time in the sources log.
+static const QString c_dateTimeFormat =
+	QStringLiteral( "yyyy-MM-dd hh:mm:ss.zzz" );
+
+
+//
+// ReplaySettings
+//
+
+/*!
+	Settings of the replay channel.
+
+	Settings are given as host address of the channel in the form of
+	"key=value" pairs separated with ';', or host address is a path
+	to the file with such pairs, one per line. Port of the channel
+	is not used.
+
+	Keys:
+
+	\li file - path to the database with the sources log, relative path
+		is relative to the directory of the configuration;
+	\li from - start of the range, "yyyy-MM-dd hh:mm:ss.zzz" (whole log);
+	\li to - end of the range, "yyyy-MM-dd hh:mm:ss.zzz" (whole log);
+	\li speed - multiplier of the speed or "max" for as fast as possible (1);
+	\li channel - name of the channel in the log to replay (all channels);
+	\li capture - path to the traffic capture of the channel, relative path
+		is relative to the directory of the configuration. If it's set
+		capture is replayed instead of the log, whole capture
+		is replayed.
+*/
+class ReplaySettings {
+public:
+	ReplaySettings()
+		:	m_speed( 1.0 )
+	{
+	}
+
+	//! \return Settings from the host address of the channel.
+	static ReplaySettings fromAddress( const QString & address )
+	{
+		ReplaySettings s;
+
+		QString text = address;
+
+		if( QFileInfo( address ).isFile() )
+		{
+			QFile file( address );
+
+			if( file.open( QIODevice::ReadOnly ) )
+			{
+				QTextStream stream( &file );
+
+				text = stream.readAll();
+
+				file.close();
+			}
+		}
+
+		text.replace( QLatin1Char( '\n' ), QLatin1Char( ';' ) );
+
+		for( const QString & pair : text.split( QLatin1Char( ';' ) ) )
+		{
+			const int pos = pair.indexOf( QLatin1Char( '=' ) );
+
+			if( pos < 0 )
+				continue;
+
+			const QString key = pair.left( pos ).trimmed().toLower();
+			const QString value = pair.mid( pos + 1 ).trimmed();
+
+			if( key == QLatin1String( "file" ) )
+			{
+				s.m_fileName = value;
+
+				if( QFileInfo( value ).isRelative() )
+					s.m_fileName.prepend( Configuration::instance().path() );
+			}
+			else if( key == QLatin1String( "from" ) )
+				s.m_from = value;
+			else if( key == QLatin1String( "to" ) )
+				s.m_to = value;
+			else if( key == QLatin1String( "speed" ) )
+			{
+				if( value == QLatin1String( "max" ) )
+					s.m_speed = 0.0;
+				else
+					s.m_speed = qMax( 0.001, value.toDouble() );
+			}
+			else if( key == QLatin1String( "channel" ) )
+				s.m_channelName = value;
+			else if( key == QLatin1String( "capture" ) )
+			{
+				s.m_captureFileName = value;
+
+				if( QFileInfo( value ).isRelative() )
+					s.m_captureFileName.prepend(
+						Configuration::instance().path() );
+			}
+		}
+
+		if( s.m_from.isEmpty() )
+			s.m_from = QStringLiteral( "0000-00-00 00:00:00.000" );
+
+		if( s.m_to.isEmpty() )
+			s.m_to = QStringLiteral( "9999-99-99 99:99:99.999" );
+
+		return s;
+	}
+
+	//! \return Is replay as fast as possible?
+	bool isMaxSpeed() const
+	{
+		return ( m_speed <= 0.0 );
+	}
+
+	//! Database file.
+	QString m_fileName;
+	//! Start of the range.
+	QString m_from;
+	//! End of the range.
+	QString m_to;
+	//! Multiplier of the speed, zero for the maximum speed.
+	double m_speed;
+	//! Name of the channel in the log, empty for all channels.
+	QString m_channelName;
+	//! Traffic capture, empty for the log.
+	QString m_captureFileName;
+}; // class ReplaySettings
+
+
+//
+// valueFromString
+//
+
+//! \return Value of the source of the given type from the log's text.
+static inline QVariant valueFromString( const QString & text,
+	Como::Source::Type type )
+{
+	switch( type )
+	{
+		case Como::Source::Int :
+			return QVariant( text.toInt() );
+		case Como::Source::UInt :
+			return QVariant( text.toUInt() );
+		case Como::Source::LongLong :
+			return QVariant( text.toLongLong() );
+		case Como::Source::ULongLong :
+			return QVariant( text.toULongLong() );
+		case Como::Source::Double :
+			return QVariant( text.toDouble() );
+		case Como::Source::DateTime :
+			return QVariant( text ).toDateTime();
+		case Como::Source::Time :
+			return QVariant( text ).toTime();
+		default :
+			return QVariant( text );
+	}
+}
+
+
+//
+// ReplayReader
+//
+
+//! Max count of the events sent in one event loop's iteration.
+static const int c_eventsPerChunk = 1000;
+
+/*!
+	Base of the readers of the recorded traffic. Lives in the thread
+	from the shared I/O thread pool, reads events one by one, so
+	recording of any size doesn't load into memory, and paces them
+	by their timestamps.
+*/
+class ReplayReader
+	:	public QObject
+{
+	Q_OBJECT
+
+signals:
+	//! Replay started.
+	void connected();
+	//! Replay stopped or finished.
+	void disconnected();
+	//! Como::Source has updated his value.
+	void sourceHasUpdatedValue( const Como::Source & source );
+	//! Como::Source has deregistered.
+	void sourceDeinitialized( const Como::Source & source );
+
+public:
+	explicit ReplayReader( const ReplaySettings & settings )
+		:	m_settings( settings )
+		,	m_nextTime( 0 )
+		,	m_isNextDeregistration( false )
+		,	m_timer( new QTimer( this ) )
+		,	m_isStarted( false )
+		,	m_startedAt( 0 )
+		,	m_firstTime( 0 )
+		,	m_hasNext( false )
+	{
+		m_timer->setSingleShot( true );
+		m_timer->setTimerType( Qt::PreciseTimer );
+
+		connect( m_timer, &QTimer::timeout,
+			this, &ReplayReader::tick );
+	}
+
+	virtual ~ReplayReader()
+	{
+	}
+
+public slots:
+	//! Start replay.
+	void start()
+	{
+		if( m_isStarted )
+			return;
+
+		if( !open() )
+		{
+			emit disconnected();
+
+			return;
+		}
+
+		m_isStarted = true;
+
+		emit connected();
+
+		m_startedAt = steadyMSecs();
+
+		m_hasNext = readNext();
+
+		if( m_hasNext )
+			m_firstTime = m_nextTime;
+
+		schedule();
+	}
+
+	//! Stop replay.
+	void stop()
+	{
+		if( !m_isStarted )
+			return;
+
+		m_isStarted = false;
+
+		m_timer->stop();
+
+		close();
+
+		m_hasNext = false;
+
+		m_sources.clear();
+
+		emit disconnected();
+	}
+
+	//! Send current values of all replayed sources.
+	void sendListOfSources()
+	{
+		for( const Como::Source & source : qAsConst( m_sources ) )
+			emit sourceHasUpdatedValue( source );
+	}
+
+protected:
+	//! Open recording. \return false on error.
+	virtual bool open() = 0;
+	//! Close recording.
+	virtual void close() = 0;
+	/*!
+		Read next event into m_next, m_nextTime (ms) and
+		m_isNextDeregistration. \return false at the end.
+	*/
+	virtual bool readNext() = 0;
+
+private slots:
+	//! Send all events that are due.
+	void tick()
+	{
+		const qint64 elapsed = steadyMSecs() - m_startedAt;
+
+		for( int i = 0; m_hasNext && i < c_eventsPerChunk; ++i )
+		{
+			if( dueTime() > elapsed )
+				break;
+
+			const QString key = m_next.name() + m_next.typeName();
+
+			if( m_isNextDeregistration )
+			{
+				m_sources.remove( key );
+
+				emit sourceDeinitialized( m_next );
+			}
+			else
+			{
+				m_sources.insert( key, m_next );
+
+				emit sourceHasUpdatedValue( m_next );
+			}
+
+			m_hasNext = readNext();
+		}
+
+		schedule();
+	}
+
+private:
+	//! \return Time of the next event from the start of the replay in ms.
+	qint64 dueTime() const
+	{
+		if( m_settings.isMaxSpeed() )
+			return 0;
+
+		return static_cast< qint64 > (
+			( m_nextTime - m_firstTime ) / m_settings.m_speed );
+	}
+
+	//! Schedule sending of the next event or stop at the end.
+	void schedule()
+	{
+		if( !m_hasNext )
+		{
+			stop();
+
+			return;
+		}
+
+		const qint64 delay = dueTime() - ( steadyMSecs() - m_startedAt );
+
+		m_timer->start( static_cast< int > ( qBound( Q_INT64_C( 0 ), delay,
+			Q_INT64_C( 0x7FFFFFFF ) ) ) );
+	}
+
+protected:
+	//! Settings.
+	ReplaySettings m_settings;
+	//! Next event.
+	Como::Source m_next;
+	//! Time of the next event in ms.
+	qint64 m_nextTime;
+	//! Is next event deregistration?
+	bool m_isNextDeregistration;
+
+private:
+	//! Timer.
+	QTimer * m_timer;
+	//! Is replay started?
+	bool m_isStarted;
+	//! Start of the replay.
+	qint64 m_startedAt;
+	//! Time of the first event.
+	qint64 m_firstTime;
+	//! Is next event read?
+	bool m_hasNext;
+	//! Last values of the replayed sources.
+	QHash< QString, Como::Source > m_sources;
+}; // class ReplayReader
+
+
+//
+// LogReplayReader
+//
+
+//! Counter for the unique names of the database connections.
+static QAtomicInt s_connectionsCounter( 0 );
+
+/*!
+	Reader of the sources log with own connection to the database
+	and forward-only query.
+*/
+class LogReplayReader
+	:	public ReplayReader
+{
+public:
+	explicit LogReplayReader( const ReplaySettings & settings )
+		:	ReplayReader( settings )
+		,	m_connectionName( QStringLiteral( "replay_channel_%1" )
+				.arg( s_connectionsCounter.fetchAndAddOrdered( 1 ) ) )
+	{
+	}
+
+	~LogReplayReader()
+	{
+		close();
+	}
+
+protected:
+	bool open()
+	{
+		{
+			QSqlDatabase db = QSqlDatabase::addDatabase(
+				QLatin1String( "QSQLITE" ), m_connectionName );
+			db.setDatabaseName( m_settings.m_fileName );
+
+			if( !db.open() )
+			{
+				db = QSqlDatabase();
+
+				QSqlDatabase::removeDatabase( m_connectionName );
+
+				return false;
+			}
+
+			m_query.reset( new QSqlQuery( db ) );
+		}
+
+		m_query->setForwardOnly( true );
+
+		QString sql = QLatin1String( "SELECT dateTime, channelName, type, "
+			"sourceName, typeName, value, desc FROM sourcesLog "
+			"WHERE dateTime BETWEEN ? AND ? " );
+
+		if( !m_settings.m_channelName.isEmpty() )
+			sql.append( QLatin1String( "AND channelName = ? " ) );
+
+		sql.append( QLatin1String( "ORDER BY dateTime" ) );
+
+		m_query->prepare( sql );
+		m_query->addBindValue( m_settings.m_from );
+		m_query->addBindValue( m_settings.m_to );
+
+		if( !m_settings.m_channelName.isEmpty() )
+			m_query->addBindValue( m_settings.m_channelName );
+
+		if( !m_query->exec() )
+		{
+			close();
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void close()
+	{
+		if( m_query )
+		{
+			m_query.reset();
+
+			QSqlDatabase::removeDatabase( m_connectionName );
+		}
+	}
+
+	bool readNext()
+	{
+		if( !m_query->next() )
+			return false;
+
+		const Como::Source::Type type =
+			static_cast< Como::Source::Type > ( m_query->value( 2 ).toInt() );
+
+		const QDateTime dateTime = QDateTime::fromString(
+			m_query->value( 0 ).toString(), c_dateTimeFormat );
+
+		m_next = Como::Source( type, m_query->value( 3 ).toString(),
+			m_query->value( 4 ).toString(),
+			valueFromString( m_query->value( 5 ).toString(), type ),
+			m_query->value( 6 ).toString() );
+		m_next.setDateTime( dateTime );
+
+		m_nextTime = dateTime.toMSecsSinceEpoch();
+		m_isNextDeregistration = false;
+
+		return true;
+	}
+
+private:
+	//! Name of the connection to the database.
+	QString m_connectionName;
+	//! Query.
+	QScopedPointer< QSqlQuery > m_query;
+}; // class LogReplayReader
+
+
+//
+// CaptureReplayReader
+//
+
+/*!
+	Reader of the traffic capture mapped to the memory. Events are
+	paced by the time of receiving.
+*/
+class CaptureReplayReader
+	:	public ReplayReader
+{
+public:
+	explicit CaptureReplayReader( const ReplaySettings & settings )
+		:	ReplayReader( settings )
+	{
+	}
+
+protected:
+	bool open()
+	{
+		m_capture.reset( new TrafficCaptureReader(
+			m_settings.m_captureFileName ) );
+
+		if( !m_capture->isOpen() )
+		{
+			m_capture.reset();
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void close()
+	{
+		m_capture.reset();
+	}
+
+	bool readNext()
+	{
+		if( !m_capture->next( m_event ) )
+			return false;
+
+		m_next = m_event.m_source;
+		m_nextTime = m_event.m_receivedAt;
+		m_isNextDeregistration =
+			( m_event.m_type == CapturedDeregistration );
+
+		return true;
+	}
+
+private:
+	//! Capture.
+	QScopedPointer< TrafficCaptureReader > m_capture;
+	//! Last read event.
+	CapturedEvent m_event;
+}; // class CaptureReplayReader
+
+
+//
+// ReaderAndThreadDeleter
+//
+
+/*!
+	Deletes reader in it's own thread and only after that
+	returns the thread to the pool.
+*/
+class ReaderAndThreadDeleter
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	ReaderAndThreadDeleter( QThread * thread, ReplayReader * reader )
+		:	m_thread( thread )
+	{
+		reader->disconnect();
+
+		connect( reader, &QObject::destroyed,
+			this, &ReaderAndThreadDeleter::readerDestroyed );
+
+		reader->deleteLater();
+	}
+
+public slots:
+	void readerDestroyed()
+	{
+		ChannelPluginInterface::releaseIOThread( m_thread );
+
+		deleteLater();
+	}
+
+private:
+	QThread * m_thread;
+}; // class ReaderAndThreadDeleter
+
+
+class ReplayChannel;
+
+//
+// ReplayChannelPrivate
+//
+
+class ReplayChannelPrivate
+	:	public IngestChannelPrivate
+{
+public:
+	ReplayChannelPrivate( ReplayChannel * parent,
+		const QString & name,
+		const QString & address,
+		quint16 port,
+		QThread * thread );
+
+	~ReplayChannelPrivate();
+
+	//! Init.
+	void init();
+
+	inline ReplayChannel * q_func();
+
+	inline const ReplayChannel * q_func() const;
+
+
+	//! Reader.
+	ReplayReader * m_reader;
+	//! Is reconnection requested by user?
+	bool m_isReconnectRequested;
+}; // class ReplayChannelPrivate
+
+
+//
+// ReplayChannel
+//
+
+/*!
+	Channel that replays sources log from the database or traffic
+	capture of the channel. Works offline,
+	"connection" starts replay from the start of the range, channel
+	disconnects at the end of the range.
+*/
+class ReplayChannel
+	:	public IngestChannel
+{
+	Q_OBJECT
+
+signals:
+	//! About to start replay.
+	void aboutToStart();
+	//! About to stop replay.
+	void aboutToStop();
+	//! About to send list of sources.
+	void aboutToSendListOfSources();
+
+public:
+	ReplayChannel(
+		//! Name of the channel.
+		const QString & name,
+		//! Settings.
+		const QString & address,
+		//! Not used.
+		quint16 port,
+		//! Thread for the reader.
+		QThread * thread );
+
+	~ReplayChannel();
+
+	//! \return Type of the channel.
+	const QString & channelType() const;
+
+protected:
+	//! Implementation of the "connect to host" operation.
+	void connectToHostImplementation();
+	//! Implementation of the "Disconnect from host" operation.
+	void disconnectFromHostImplementation();
+	//! Implementation of the "reconnect to host" operation.
+	void reconnectToHostImplementation();
+	//! Request list of sources from the reader.
+	void requestSources();
+
+private slots:
+	//! Replay started.
+	void readerStarted();
+	//! Replay stopped.
+	void readerStopped();
+
+private:
+	Q_DISABLE_COPY( ReplayChannel )
+
+	friend class ReplayChannelPrivate;
+
+	inline ReplayChannelPrivate * d_func()
+		{ return static_cast< ReplayChannelPrivate* > ( d.data() ); }
+	inline const ReplayChannelPrivate * d_func() const
+		{ return static_cast< const ReplayChannelPrivate* >( d.data() ); }
+}; // class ReplayChannel
+
+
+//
+// ReplayChannelPrivate
+//
+
+ReplayChannelPrivate::ReplayChannelPrivate( ReplayChannel * parent,
+	const QString & name,
+	const QString & address,
+	quint16 port,
+	QThread * thread )
+	:	IngestChannelPrivate( parent, name, address, port, thread )
+	,	m_reader( 0 )
+	,	m_isReconnectRequested( false )
+{}
+
+ReplayChannelPrivate::~ReplayChannelPrivate()
+{
+	ReaderAndThreadDeleter * deleter = new ReaderAndThreadDeleter(
+		m_thread, m_reader );
+
+	Q_UNUSED( deleter )
+}
+
+void
+ReplayChannelPrivate::init()
+{
+	const ReplaySettings settings = ReplaySettings::fromAddress( m_address );
+
+	if( settings.m_captureFileName.isEmpty() )
+		m_reader = new LogReplayReader( settings );
+	else
+		m_reader = new CaptureReplayReader( settings );
+}
+
+inline ReplayChannel *
+ReplayChannelPrivate::q_func()
+{
+	return static_cast< ReplayChannel* >( q );
+}
+
+inline const ReplayChannel *
+ReplayChannelPrivate::q_func() const
+{
+	return static_cast< const ReplayChannel* >( q );
+}
+
+
+//
+// ReplayChannel
+//
+
+ReplayChannel::ReplayChannel( const QString & name,
+	const QString & address, quint16 port, QThread * thread )
+	:	IngestChannel( new ReplayChannelPrivate( this, name, address, port,
+			thread ) )
+{
+	ReplayChannelPrivate * d = d_func();
+
+	d->init();
+
+	initCoalescer( d->m_reader );
+
+	connect( this, &ReplayChannel::aboutToStart,
+		d->m_reader, &ReplayReader::start,
+		Qt::QueuedConnection );
+
+	connect( this, &ReplayChannel::aboutToStop,
+		d->m_reader, &ReplayReader::stop,
+		Qt::QueuedConnection );
+
+	connect( this, &ReplayChannel::aboutToSendListOfSources,
+		d->m_reader, &ReplayReader::sendListOfSources,
+		Qt::QueuedConnection );
+
+	// Coalescer lives in the reader's thread, so these connections
+	// are direct.
+	connect( d->m_reader, &ReplayReader::sourceHasUpdatedValue,
+		d->m_coalescer, &SourcesCoalescer::sourceHasUpdatedValue );
+
+	connect( d->m_reader, &ReplayReader::sourceDeinitialized,
+		d->m_coalescer, &SourcesCoalescer::sourceHasDeregistered );
+
+	connect( d->m_reader, &ReplayReader::disconnected,
+		d->m_coalescer, &SourcesCoalescer::flush );
+
+	connect( d->m_reader, &ReplayReader::disconnected,
+		d->m_coalescer, &SourcesCoalescer::forgetValues );
+
+	connect( d->m_reader, &ReplayReader::connected,
+		this, &ReplayChannel::readerStarted,
+		Qt::QueuedConnection );
+
+	connect( d->m_reader, &ReplayReader::disconnected,
+		this, &ReplayChannel::readerStopped,
+		Qt::QueuedConnection );
+
+	d->m_reader->moveToThread( d->m_thread );
+}
+
+ReplayChannel::~ReplayChannel()
+{
+}
+
+static const QString c_replayChannelType = QStringLiteral( "replay" );
+
+const QString &
+ReplayChannel::channelType() const
+{
+	return c_replayChannelType;
+}
+
+void
+ReplayChannel::connectToHostImplementation()
+{
+	ReplayChannelPrivate * d = d_func();
+
+	d->m_isDisconnectedByUser = false;
+
+	emit aboutToStart();
+}
+
+void
+ReplayChannel::disconnectFromHostImplementation()
+{
+	ReplayChannelPrivate * d = d_func();
+
+	d->m_isDisconnectedByUser = true;
+
+	emit aboutToStop();
+}
+
+void
+ReplayChannel::reconnectToHostImplementation()
+{
+	ReplayChannelPrivate * d = d_func();
+
+	d->m_isDisconnectedByUser = false;
+
+	if( d->m_isConnected )
+	{
+		d->m_isReconnectRequested = true;
+
+		emit aboutToStop();
+	}
+	else
+		emit aboutToStart();
+}
+
+void
+ReplayChannel::requestSources()
+{
+	emit aboutToSendListOfSources();
+}
+
+void
+ReplayChannel::readerStarted()
+{
+	ReplayChannelPrivate * d = d_func();
+
+	d->m_isConnected = true;
+
+	emit connected();
+}
+
+void
+ReplayChannel::readerStopped()
+{
+	ReplayChannelPrivate * d = d_func();
+
+	d->m_isConnected = false;
+
+	emit disconnected();
+
+	if( d->m_isReconnectRequested )
+	{
+		d->m_isReconnectRequested = false;
+
+		emit aboutToStart();
+	}
+}
+
+
+//
+// ReplayChannelPlugin
+//
+
+//! Plugin.
+class ReplayChannelPlugin
+	:	public QObject
+	,	public ChannelPluginInterface
+{
+	Q_OBJECT
+	Q_PLUGIN_METADATA( IID "Globe.ChannelPluginInterface.Replay" )
+	Q_INTERFACES( Globe::ChannelPluginInterface )
+
+public:
+	ReplayChannelPlugin()
+	{
+	}
+
+	~ReplayChannelPlugin()
+	{
+	}
+
+	Channel * createChannel(
+		//! Name of the channel
+		const QString & name,
+		//! Settings of the replay.
+		const QString & hostAddress,
+		//! Not used.
+		quint16 port ) const
+	{
+		return ( new ReplayChannel( name, hostAddress, port,
+			acquireIOThread() ) );
+	}
+
+	QString channelType() const
+	{
+		return c_replayChannelType;
+	}
+}; // class ReplayChannelPlugin
+
+} /* namespace Globe */
+
+#include "plugin.moc"
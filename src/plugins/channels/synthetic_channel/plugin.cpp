@@ -0,0 +1,798 @@
+
+/*!
+	\file
+
+	\author Igor Mironchik (igor.mironchik at gmail dot com).
+
+	Copyright (c) 2012-2020 Igor Mironchik
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Core include.
+#include <Core/ingest_channel.hpp>
+#include <Core/sources_coalescer.hpp>
+
+// Qt include.
+#include <QThread>
+#include <QTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDateTime>
+#include <QVector>
+
+// C++ include.
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+
+namespace Globe {
+
+//
+// Distribution
+//
+
+//! Distribution of the updates between sources.
+enum Distribution {
+	//! All sources are updated with the same probability.
+	Uniform,
+	//! Uniform, but updates of the period are sent in one burst.
+	Bursty,
+	//! Zipf distribution, i.e. small hot set of the sources.
+	Zipf
+}; // enum Distribution
+
+
+//
+// SyntheticSettings
+//
+
+/*!
+	Settings of the synthetic channel.
+
+	Settings are given as host address of the channel in the form of
+	"key=value" pairs separated with ';', or host address is a path
+	to the file with such pairs, one per line. Port of the channel is
+	the seed of the random generator.
+
+	Keys:
+
+	\li sources - count of the sources (1000);
+	\li rate - count of the updates per second (1000);
+	\li distribution - uniform, bursty or zipf (uniform);
+	\li zipf - exponent of the Zipf distribution (1.0);
+	\li burst - period of the bursts in ms (1000);
+	\li churn - count of the deregistrations per second (0).
+*/
+class SyntheticSettings {
+public:
+	SyntheticSettings()
+		:	m_sourcesCount( 1000 )
+		,	m_rate( 1000 )
+		,	m_distribution( Uniform )
+		,	m_zipfExponent( 1.0 )
+		,	m_burstPeriod( 1000 )
+		,	m_churn( 0 )
+		,	m_seed( 0 )
+	{
+	}
+
+	//! \return Settings from the host address and port of the channel.
+	static SyntheticSettings fromAddress( const QString & address,
+		quint16 port )
+	{
+		SyntheticSettings s;
+		s.m_seed = port;
+
+		QString text = address;
+
+		if( QFileInfo( address ).isFile() )
+		{
+			QFile file( address );
+
+			if( file.open( QIODevice::ReadOnly ) )
+			{
+				QTextStream stream( &file );
+
+				text = stream.readAll();
+
+				file.close();
+			}
+		}
+
+		text.replace( QLatin1Char( '\n' ), QLatin1Char( ';' ) );
+
+		for( const QString & pair : text.split( QLatin1Char( ';' ) ) )
+		{
+			const int pos = pair.indexOf( QLatin1Char( '=' ) );
+
+			if( pos < 0 )
+				continue;
+
+			const QString key = pair.left( pos ).trimmed().toLower();
+			const QString value = pair.mid( pos + 1 ).trimmed();
+
+			if( key == QLatin1String( "sources" ) )
+				s.m_sourcesCount = qMax( 1, value.toInt() );
+			else if( key == QLatin1String( "rate" ) )
+				s.m_rate = qMax( 0, value.toInt() );
+			else if( key == QLatin1String( "distribution" ) )
+			{
+				if( value == QLatin1String( "bursty" ) )
+					s.m_distribution = Bursty;
+				else if( value == QLatin1String( "zipf" ) )
+					s.m_distribution = Zipf;
+				else
+					s.m_distribution = Uniform;
+			}
+			else if( key == QLatin1String( "zipf" ) )
+				s.m_zipfExponent = qMax( 0.0, value.toDouble() );
+			else if( key == QLatin1String( "burst" ) )
+				s.m_burstPeriod = qMax( 1, value.toInt() );
+			else if( key == QLatin1String( "churn" ) )
+				s.m_churn = qMax( 0, value.toInt() );
+		}
+
+		return s;
+	}
+
+	//! Count of the sources.
+	int m_sourcesCount;
+	//! Count of the updates per second.
+	int m_rate;
+	//! Distribution of the updates.
+	Distribution m_distribution;
+	//! Exponent of the Zipf distribution.
+	double m_zipfExponent;
+	//! Period of the bursts in ms.
+	int m_burstPeriod;
+	//! Count of the deregistrations per second.
+	int m_churn;
+	//! Seed of the random generator.
+	quint16 m_seed;
+}; // class SyntheticSettings
+
+
+//
+// SyntheticGenerator
+//
+
+//! Period of the generator's ticks in ms.
+static const int c_tickPeriod = 10;
+
+//! Types of the generated sources.
+static const Como::Source::Type c_types[] = {
+	Como::Source::Int,
+	Como::Source::UInt,
+	Como::Source::LongLong,
+	Como::Source::ULongLong,
+	Como::Source::String,
+	Como::Source::Double,
+	Como::Source::DateTime,
+	Como::Source::Time
+};
+
+//! Type names of the generated sources.
+static const char * c_typeNames[] = {
+	"Int",
+	"UInt",
+	"LongLong",
+	"ULongLong",
+	"String",
+	"Double",
+	"DateTime",
+	"Time"
+};
+
+static const int c_typesCount = sizeof( c_types ) / sizeof( c_types[ 0 ] );
+
+/*!
+	Generator of the sources. Lives in the thread from the shared
+	I/O thread pool and plays role of the socket for the channel.
+*/
+class SyntheticGenerator
+	:	public QObject
+{
+	Q_OBJECT
+
+signals:
+	//! Generation started.
+	void connected();
+	//! Generation stopped.
+	void disconnected();
+	//! Como::Source has updated his value.
+	void sourceHasUpdatedValue( const Como::Source & source );
+	//! Como::Source has deregistered.
+	void sourceDeinitialized( const Como::Source & source );
+
+public:
+	explicit SyntheticGenerator( const SyntheticSettings & settings )
+		:	m_settings( settings )
+		,	m_random( settings.m_seed )
+		,	m_timer( new QTimer( this ) )
+		,	m_lastTick( 0 )
+		,	m_burstStart( 0 )
+		,	m_updatesBudget( 0.0 )
+		,	m_churnBudget( 0.0 )
+	{
+		m_sources.reserve( m_settings.m_sourcesCount );
+		m_registered.fill( false, m_settings.m_sourcesCount );
+
+		for( int i = 0; i < m_settings.m_sourcesCount; ++i )
+		{
+			const int t = i % c_typesCount;
+
+			m_sources.append( Como::Source( c_types[ t ],
+				QStringLiteral( "synthetic.%1" ).arg( i ),
+				QLatin1String( c_typeNames[ t ] ), QVariant(),
+				QString() ) );
+		}
+
+		if( m_settings.m_distribution == Zipf )
+			initZipf();
+
+		connect( m_timer, &QTimer::timeout,
+			this, &SyntheticGenerator::tick );
+	}
+
+public slots:
+	//! Start generation.
+	void start()
+	{
+		if( m_timer->isActive() )
+			return;
+
+		m_lastTick = steadyMSecs();
+		m_burstStart = m_lastTick;
+		m_updatesBudget = 0.0;
+		m_churnBudget = 0.0;
+
+		m_timer->start( c_tickPeriod );
+
+		emit connected();
+	}
+
+	//! Stop generation.
+	void stop()
+	{
+		if( !m_timer->isActive() )
+			return;
+
+		m_timer->stop();
+
+		m_registered.fill( false );
+
+		emit disconnected();
+	}
+
+	//! Send current values of all registered sources.
+	void sendListOfSources()
+	{
+		for( int i = 0; i < m_sources.size(); ++i )
+		{
+			if( m_registered.at( i ) )
+				emit sourceHasUpdatedValue( m_sources.at( i ) );
+		}
+	}
+
+private slots:
+	//! Generate updates for the elapsed time.
+	void tick()
+	{
+		const qint64 now = steadyMSecs();
+		const qint64 elapsed = now - m_lastTick;
+		m_lastTick = now;
+
+		m_updatesBudget += m_settings.m_rate * elapsed / 1000.0;
+		m_churnBudget += m_settings.m_churn * elapsed / 1000.0;
+
+		// No more than one second or one burst period of updates at once.
+		m_updatesBudget = qMin( m_updatesBudget,
+			static_cast< double > ( qMax( m_settings.m_rate, 1 ) ) *
+				qMax( m_settings.m_burstPeriod, 1000 ) / 1000.0 );
+
+		if( m_settings.m_distribution == Bursty &&
+			now - m_burstStart < m_settings.m_burstPeriod )
+				return;
+
+		m_burstStart = now;
+
+		const QDateTime dt = QDateTime::currentDateTime();
+
+		for( ; m_updatesBudget >= 1.0; m_updatesBudget -= 1.0 )
+			update( nextIndex(), dt );
+
+		for( ; m_churnBudget >= 1.0; m_churnBudget -= 1.0 )
+			deregister( uniformIndex() );
+	}
+
+private:
+	//! \return Index of the source uniformly distributed.
+	int uniformIndex()
+	{
+		return std::uniform_int_distribution< int > (
+			0, m_sources.size() - 1 )( m_random );
+	}
+
+	//! \return Index of the next source to update.
+	int nextIndex()
+	{
+		if( m_settings.m_distribution == Zipf )
+		{
+			const double p = std::uniform_real_distribution< double > (
+				0.0, 1.0 )( m_random );
+
+			const auto it = std::lower_bound( m_zipfCdf.cbegin(),
+				m_zipfCdf.cend(), p );
+
+			return qMin( static_cast< int > ( it - m_zipfCdf.cbegin() ),
+				m_sources.size() - 1 );
+		}
+		else
+			return uniformIndex();
+	}
+
+	//! Init cumulative distribution function of the Zipf distribution.
+	void initZipf()
+	{
+		m_zipfCdf.resize( m_sources.size() );
+
+		double sum = 0.0;
+
+		for( int i = 0; i < m_sources.size(); ++i )
+		{
+			sum += 1.0 / std::pow( i + 1, m_settings.m_zipfExponent );
+			m_zipfCdf[ i ] = sum;
+		}
+
+		for( double & v : m_zipfCdf )
+			v /= sum;
+	}
+
+	//! \return New value for the source of the given type.
+	QVariant nextValue( Como::Source::Type type, const QDateTime & dt )
+	{
+		const int v = std::uniform_int_distribution< int > (
+			0, 1000 )( m_random );
+
+		switch( type )
+		{
+			case Como::Source::Int :
+				return QVariant( v - 500 );
+			case Como::Source::UInt :
+				return QVariant( static_cast< uint > ( v ) );
+			case Como::Source::LongLong :
+				return QVariant( static_cast< qlonglong > ( v ) * 1000000 );
+			case Como::Source::ULongLong :
+				return QVariant( static_cast< qulonglong > ( v ) * 1000000 );
+			case Como::Source::String :
+				return QVariant( QStringLiteral( "value %1" ).arg( v ) );
+			case Como::Source::Double :
+				return QVariant( v / 10.0 );
+			case Como::Source::DateTime :
+				return QVariant( dt );
+			case Como::Source::Time :
+				return QVariant( dt.time() );
+		}
+
+		return QVariant();
+	}
+
+	//! Update (and register if needed) source with the given index.
+	void update( int index, const QDateTime & dt )
+	{
+		Como::Source & source = m_sources[ index ];
+
+		source.setValue( nextValue( source.type(), dt ) );
+		source.setDateTime( dt );
+
+		m_registered[ index ] = true;
+
+		emit sourceHasUpdatedValue( source );
+	}
+
+	//! Deregister source with the given index.
+	void deregister( int index )
+	{
+		if( m_registered.at( index ) )
+		{
+			m_registered[ index ] = false;
+
+			emit sourceDeinitialized( m_sources.at( index ) );
+		}
+	}
+
+private:
+	//! Settings.
+	SyntheticSettings m_settings;
+	//! Random generator.
+	std::mt19937 m_random;
+	//! Timer of the ticks.
+	QTimer * m_timer;
+	//! Sources.
+	QVector< Como::Source > m_sources;
+	//! Is source registered?
+	QVector< bool > m_registered;
+	//! Cumulative distribution function for Zipf distribution.
+	QVector< double > m_zipfCdf;
+	//! Time of the last tick.
+	qint64 m_lastTick;
+	//! Start time of the current burst.
+	qint64 m_burstStart;
+	//! Count of the updates to generate.
+	double m_updatesBudget;
+	//! Count of the deregistrations to generate.
+	double m_churnBudget;
+}; // class SyntheticGenerator
+
+
+//
+// GeneratorAndThreadDeleter
+//
+
+/*!
+	Deletes generator in it's own thread and only after that
+	returns the thread to the pool.
+*/
+class GeneratorAndThreadDeleter
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	GeneratorAndThreadDeleter( QThread * thread,
+		SyntheticGenerator * generator )
+		:	m_thread( thread )
+	{
+		generator->disconnect();
+
+		connect( generator, &QObject::destroyed,
+			this, &GeneratorAndThreadDeleter::generatorDestroyed );
+
+		generator->deleteLater();
+	}
+
+public slots:
+	void generatorDestroyed()
+	{
+		ChannelPluginInterface::releaseIOThread( m_thread );
+
+		deleteLater();
+	}
+
+private:
+	QThread * m_thread;
+}; // class GeneratorAndThreadDeleter
+
+
+class SyntheticChannel;
+
+//
+// SyntheticChannelPrivate
+//
+
+class SyntheticChannelPrivate
+	:	public IngestChannelPrivate
+{
+public:
+	SyntheticChannelPrivate( SyntheticChannel * parent,
+		const QString & name,
+		const QString & address,
+		quint16 port,
+		QThread * thread );
+
+	~SyntheticChannelPrivate();
+
+	//! Init.
+	void init();
+
+	inline SyntheticChannel * q_func();
+
+	inline const SyntheticChannel * q_func() const;
+
+
+	//! Generator.
+	SyntheticGenerator * m_generator;
+	//! Is reconnection requested by user?
+	bool m_isReconnectRequested;
+}; // class SyntheticChannelPrivate
+
+
+//
+// SyntheticChannel
+//
+
+/*!
+	Channel with synthetic sources for the load testing.
+	Works offline, "connection" starts generation.
+*/
+class SyntheticChannel
+	:	public IngestChannel
+{
+	Q_OBJECT
+
+signals:
+	//! About to start generation.
+	void aboutToStart();
+	//! About to stop generation.
+	void aboutToStop();
+	//! About to send list of sources.
+	void aboutToSendListOfSources();
+
+public:
+	SyntheticChannel(
+		//! Name of the channel.
+		const QString & name,
+		//! Settings.
+		const QString & address,
+		//! Seed.
+		quint16 port,
+		//! Thread for the generator.
+		QThread * thread );
+
+	~SyntheticChannel();
+
+	//! \return Type of the channel.
+	const QString & channelType() const;
+
+protected:
+	//! Implementation of the "connect to host" operation.
+	void connectToHostImplementation();
+	//! Implementation of the "Disconnect from host" operation.
+	void disconnectFromHostImplementation();
+	//! Implementation of the "reconnect to host" operation.
+	void reconnectToHostImplementation();
+	//! Request list of sources from the generator.
+	void requestSources();
+
+private slots:
+	//! Generation started.
+	void generatorStarted();
+	//! Generation stopped.
+	void generatorStopped();
+
+private:
+	Q_DISABLE_COPY( SyntheticChannel )
+
+	friend class SyntheticChannelPrivate;
+
+	inline SyntheticChannelPrivate * d_func()
+		{ return static_cast< SyntheticChannelPrivate* > ( d.data() ); }
+	inline const SyntheticChannelPrivate * d_func() const
+		{ return static_cast< const SyntheticChannelPrivate* >( d.data() ); }
+}; // class SyntheticChannel
+
+
+//
+// SyntheticChannelPrivate
+//
+
+SyntheticChannelPrivate::SyntheticChannelPrivate( SyntheticChannel * parent,
+	const QString & name,
+	const QString & address,
+	quint16 port,
+	QThread * thread )
+	:	IngestChannelPrivate( parent, name, address, port, thread )
+	,	m_generator( 0 )
+	,	m_isReconnectRequested( false )
+{}
+
+SyntheticChannelPrivate::~SyntheticChannelPrivate()
+{
+	GeneratorAndThreadDeleter * deleter = new GeneratorAndThreadDeleter(
+		m_thread, m_generator );
+
+	Q_UNUSED( deleter )
+}
+
+void
+SyntheticChannelPrivate::init()
+{
+	m_generator = new SyntheticGenerator(
+		SyntheticSettings::fromAddress( m_address, m_port ) );
+}
+
+inline SyntheticChannel *
+SyntheticChannelPrivate::q_func()
+{
+	return static_cast< SyntheticChannel* >( q );
+}
+
+inline const SyntheticChannel *
+SyntheticChannelPrivate::q_func() const
+{
+	return static_cast< const SyntheticChannel* >( q );
+}
+
+
+//
+// SyntheticChannel
+//
+
+SyntheticChannel::SyntheticChannel( const QString & name,
+	const QString & address, quint16 port, QThread * thread )
+	:	IngestChannel( new SyntheticChannelPrivate( this, name, address, port,
+			thread ) )
+{
+	SyntheticChannelPrivate * d = d_func();
+
+	d->init();
+
+	initCoalescer( d->m_generator );
+
+	connect( this, &SyntheticChannel::aboutToStart,
+		d->m_generator, &SyntheticGenerator::start,
+		Qt::QueuedConnection );
+
+	connect( this, &SyntheticChannel::aboutToStop,
+		d->m_generator, &SyntheticGenerator::stop,
+		Qt::QueuedConnection );
+
+	connect( this, &SyntheticChannel::aboutToSendListOfSources,
+		d->m_generator, &SyntheticGenerator::sendListOfSources,
+		Qt::QueuedConnection );
+
+	// Coalescer lives in the generator's thread, so these connections
+	// are direct.
+	connect( d->m_generator, &SyntheticGenerator::sourceHasUpdatedValue,
+		d->m_coalescer, &SourcesCoalescer::sourceHasUpdatedValue );
+
+	connect( d->m_generator, &SyntheticGenerator::sourceDeinitialized,
+		d->m_coalescer, &SourcesCoalescer::sourceHasDeregistered );
+
+	connect( d->m_generator, &SyntheticGenerator::disconnected,
+		d->m_coalescer, &SourcesCoalescer::flush );
+
+	connect( d->m_generator, &SyntheticGenerator::disconnected,
+		d->m_coalescer, &SourcesCoalescer::forgetValues );
+
+	connect( d->m_generator, &SyntheticGenerator::connected,
+		this, &SyntheticChannel::generatorStarted,
+		Qt::QueuedConnection );
+
+	connect( d->m_generator, &SyntheticGenerator::disconnected,
+		this, &SyntheticChannel::generatorStopped,
+		Qt::QueuedConnection );
+
+	d->m_generator->moveToThread( d->m_thread );
+}
+
+SyntheticChannel::~SyntheticChannel()
+{
+}
+
+static const QString c_syntheticChannelType = QStringLiteral( "synthetic" );
+
+const QString &
+SyntheticChannel::channelType() const
+{
+	return c_syntheticChannelType;
+}
+
+void
+SyntheticChannel::connectToHostImplementation()
+{
+	SyntheticChannelPrivate * d = d_func();
+
+	d->m_isDisconnectedByUser = false;
+
+	emit aboutToStart();
+}
+
+void
+SyntheticChannel::disconnectFromHostImplementation()
+{
+	SyntheticChannelPrivate * d = d_func();
+
+	d->m_isDisconnectedByUser = true;
+
+	emit aboutToStop();
+}
+
+void
+SyntheticChannel::reconnectToHostImplementation()
+{
+	SyntheticChannelPrivate * d = d_func();
+
+	d->m_isDisconnectedByUser = false;
+
+	if( d->m_isConnected )
+	{
+		d->m_isReconnectRequested = true;
+
+		emit aboutToStop();
+	}
+	else
+		emit aboutToStart();
+}
+
+void
+SyntheticChannel::requestSources()
+{
+	emit aboutToSendListOfSources();
+}
+
+void
+SyntheticChannel::generatorStarted()
+{
+	SyntheticChannelPrivate * d = d_func();
+
+	d->m_isConnected = true;
+
+	emit connected();
+}
+
+void
+SyntheticChannel::generatorStopped()
+{
+	SyntheticChannelPrivate * d = d_func();
+
+	d->m_isConnected = false;
+
+	emit disconnected();
+
+	if( d->m_isReconnectRequested )
+	{
+		d->m_isReconnectRequested = false;
+
+		emit aboutToStart();
+	}
+}
+
+
+//
+// SyntheticChannelPlugin
+//
+
+//! Plugin.
+class SyntheticChannelPlugin
+	:	public QObject
+	,	public ChannelPluginInterface
+{
+	Q_OBJECT
+	Q_PLUGIN_METADATA( IID "Globe.ChannelPluginInterface.Synthetic" )
+	Q_INTERFACES( Globe::ChannelPluginInterface )
+
+public:
+	SyntheticChannelPlugin()
+	{
+	}
+
+	~SyntheticChannelPlugin()
+	{
+	}
+
+	Channel * createChannel(
+		//! Name of the channel
+		const QString & name,
+		//! Settings of the generator.
+		const QString & hostAddress,
+		//! Seed of the generator.
+		quint16 port ) const
+	{
+		return ( new SyntheticChannel( name, hostAddress, port,
+			acquireIOThread() ) );
+	}
+
+	QString channelType() const
+	{
+		return c_syntheticChannelType;
+	}
+}; // class SyntheticChannelPlugin
+
+} /* namespace Globe */
+
+#include "plugin.moc"